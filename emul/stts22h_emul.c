@@ -0,0 +1,88 @@
+/*
+ * stts22h_emul.c
+ *
+ * Emulated STTS22H temperature sensor for native_sim (see the stts22h node in
+ * boards/native_sim.overlay). It sits on the emulated I2C controller and
+ * answers register reads like the real chip, so main_morse_Geoff.c's
+ * telemetry runs unchanged: WHOAMI = 0xA0, and the temperature slowly ramps
+ * from 20.00 to 29.99 degC and back (one step of 0.01 degC per 100 ms).
+ *
+ * Only built when CONFIG_EMUL is on (boards/native_sim.conf, CMakeLists.txt).
+ */
+
+#define DT_DRV_COMPAT st_stts22h
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+
+#define STTS22H_REGS 0x10
+
+struct stts22h_emul_data {
+	uint8_t regs[STTS22H_REGS];
+	uint8_t ptr;  // register pointer (set by the first byte of a write)
+};
+
+/* Fill the temperature registers with the value "now". */
+static void stts22h_emul_update(struct stts22h_emul_data* data)
+{
+	uint32_t step = (uint32_t)(k_uptime_get() / 100) % 2000U;
+	int16_t centi = (int16_t)(2000 + ((step < 1000U) ? step : 2000U - step));
+
+	data->regs[0x06] = (uint8_t)centi;
+	data->regs[0x07] = (uint8_t)((uint16_t)centi >> 8);
+}
+
+static int stts22h_emul_transfer(const struct emul* target, struct i2c_msg* msgs, int num_msgs, int addr)
+{
+	struct stts22h_emul_data* data = target->data;
+
+	ARG_UNUSED(addr);
+
+	for (int i = 0; i < num_msgs; i++) {
+		if ((msgs[i].flags & I2C_MSG_READ) == I2C_MSG_READ) {
+			stts22h_emul_update(data);
+			for (uint32_t n = 0; n < msgs[i].len; n++) {
+				msgs[i].buf[n] = data->regs[data->ptr++ % STTS22H_REGS];
+			}
+		} else if (msgs[i].len > 0U) {
+			data->ptr = msgs[i].buf[0];
+			for (uint32_t n = 1; n < msgs[i].len; n++) {
+				data->regs[data->ptr++ % STTS22H_REGS] = msgs[i].buf[n];
+			}
+		}
+	}
+	return 0;
+}
+
+static const struct i2c_emul_api stts22h_emul_api = {
+	.transfer = stts22h_emul_transfer,
+};
+
+static int stts22h_emul_init(const struct emul* target, const struct device* parent)
+{
+	struct stts22h_emul_data* data = target->data;
+
+	ARG_UNUSED(parent);
+	data->regs[0x01] = 0xA0;  // WHOAMI
+	data->ptr = 0;
+	return 0;
+}
+
+/* The emulator needs a device for its node; the app talks to the bus directly, so it does nothing. */
+static int stts22h_emul_dev_init(const struct device* dev)
+{
+	ARG_UNUSED(dev);
+	return 0;
+}
+
+#define STTS22H_EMUL(n)                                                                      \
+	static struct stts22h_emul_data stts22h_emul_data_##n;                               \
+	EMUL_DT_INST_DEFINE(n, stts22h_emul_init, &stts22h_emul_data_##n, NULL,              \
+	                    &stts22h_emul_api, NULL);                                        \
+	DEVICE_DT_INST_DEFINE(n, stts22h_emul_dev_init, NULL, NULL, NULL, POST_KERNEL,       \
+	                      CONFIG_APPLICATION_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(STTS22H_EMUL)
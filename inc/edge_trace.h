@@ -0,0 +1,204 @@
+#ifndef EDGE_TRACE_H
+#define EDGE_TRACE_H
+
+#include <stdlib.h>                // strtoul()
+#include <string.h>                // strcmp()
+#include <zephyr/kernel.h>         // k_cycle_get_32(), k_work_delayable
+#include <zephyr/sys/atomic.h>     // atomic_inc()
+#include <zephyr/sys/byteorder.h>  // sys_put_le32()
+#include <zephyr/shell/shell.h>    // shell_print(), shell_hexdump_line()
+#include <morse_shell.h>           // the "morse" command
+
+/*
+ * Edge trace: a ring buffer with one entry per LED transition.
+ *
+ *   channel, level, timestamp (hardware cycles), deadline (cycles)
+ *
+ * Writing an entry is one atomic increment to claim a slot plus a few stores,
+ * so it is cheap enough for every edge and safe from any thread or ISR. The
+ * ring just overwrites the oldest entries. Each slot also stores the number it
+ * was claimed with, so a reader can tell old, new and half-written slots apart.
+ *
+ * Shell:
+ *   morse trace dump [n]     last n edges as text (default 32)
+ *   morse trace bin [n]      last n edges as hex of the packed records below
+ *   morse trace stream on|off   print new edges (binary hex) every 100 ms
+ *
+ * Packed record (12 bytes, little endian):
+ *   u32 timestamp cycles, u32 deadline cycles, u8 channel, u8 level, u16 seq
+ * seq is the low 16 bits of the entry number, so a host tool can spot gaps.
+ *
+ * Deadlines come in as kernel ticks and are converted with
+ * k_ticks_to_cyc_floor32(), which lines up with k_cycle_get_32() because both
+ * count from boot; "late" = timestamp - deadline.
+ */
+
+#define EDGE_TRACE_LEN 256  // entries, must be a power of two
+
+struct edge_trace_entry {
+	atomic_t seq;         // claim number + 1 once complete (0 = never written)
+	uint32_t t;           // k_cycle_get_32() at the edge
+	uint32_t deadline;    // when the edge should have happened (cycles)
+	uint8_t chan;
+	uint8_t level;
+};
+
+static struct edge_trace_entry edge_trace[EDGE_TRACE_LEN];
+static atomic_t edge_trace_head;  // claim numbers handed out so far
+
+/* Hot path: record one edge. deadline is in cycles (k_ticks_to_cyc_floor32()). */
+static inline void edge_trace_record(uint8_t chan, uint8_t level, uint32_t deadline)
+{
+	atomic_val_t n = atomic_inc(&edge_trace_head);  // returns the old value
+	struct edge_trace_entry* e = &edge_trace[(size_t)n & (EDGE_TRACE_LEN - 1)];
+
+	atomic_set(&e->seq, 0);  // being written
+	e->t = k_cycle_get_32();
+	e->deadline = deadline;
+	e->chan = chan;
+	e->level = level;
+	atomic_set(&e->seq, n + 1);  // complete
+}
+
+/*
+ * Copy entry number n out of the ring. Returns false if it was already
+ * overwritten or is still being written.
+ */
+static bool edge_trace_get(atomic_val_t n, struct edge_trace_entry* out)
+{
+	const struct edge_trace_entry* e = &edge_trace[(size_t)n & (EDGE_TRACE_LEN - 1)];
+
+	if (atomic_get(&e->seq) != n + 1) {
+		return false;
+	}
+	out->t = e->t;
+	out->deadline = e->deadline;
+	out->chan = e->chan;
+	out->level = e->level;
+	return atomic_get(&e->seq) == n + 1;  // not overwritten while we copied
+}
+
+/* Fill the 12-byte packed record for entry n. */
+static void edge_trace_pack(atomic_val_t n, const struct edge_trace_entry* e, uint8_t rec[12])
+{
+	sys_put_le32(e->t, &rec[0]);
+	sys_put_le32(e->deadline, &rec[4]);
+	rec[8] = e->chan;
+	rec[9] = e->level;
+	sys_put_le16((uint16_t)n, &rec[10]);
+}
+
+/* First entry number worth reading when we want the last count edges. */
+static atomic_val_t edge_trace_first(size_t count)
+{
+	atomic_val_t head = atomic_get(&edge_trace_head);
+
+	if (count > EDGE_TRACE_LEN) {
+		count = EDGE_TRACE_LEN;
+	}
+	return (head > (atomic_val_t)count) ? head - (atomic_val_t)count : 0;
+}
+
+/* Optional [n] argument of dump/bin. */
+static size_t edge_trace_count_arg(size_t argc, char** argv)
+{
+	return (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 32U;
+}
+
+static int cmd_trace_dump(const struct shell* sh, size_t argc, char** argv)
+{
+	struct edge_trace_entry e;
+	atomic_val_t head = atomic_get(&edge_trace_head);
+
+	for (atomic_val_t n = edge_trace_first(edge_trace_count_arg(argc, argv)); n < head; n++) {
+		if (!edge_trace_get(n, &e)) {
+			continue;
+		}
+		int32_t late = (int32_t)(e.t - e.deadline);  // cycles, negative = early
+
+		shell_print(sh, "%6ld ch%u %s t=%u late=%s%u us", (long)n, e.chan, e.level ? "ON " : "OFF",
+		            e.t, (late < 0) ? "-" : "",
+		            k_cyc_to_us_floor32((late < 0) ? (uint32_t)-late : (uint32_t)late));
+	}
+	return 0;
+}
+
+static int cmd_trace_bin(const struct shell* sh, size_t argc, char** argv)
+{
+	struct edge_trace_entry e;
+	uint8_t rec[12];
+	atomic_val_t head = atomic_get(&edge_trace_head);
+
+	for (atomic_val_t n = edge_trace_first(edge_trace_count_arg(argc, argv)); n < head; n++) {
+		if (edge_trace_get(n, &e)) {
+			edge_trace_pack(n, &e, rec);
+			shell_hexdump_line(sh, 0, rec, sizeof(rec));
+		}
+	}
+	return 0;
+}
+
+/*
+ * Streaming: a work item prints whatever was recorded since its last run.
+ * It is defined once here; "on" and "off" only schedule and cancel it.
+ */
+static const struct shell* trace_stream_sh;
+static atomic_val_t trace_stream_next;
+static atomic_t trace_stream_on;
+
+static void trace_stream_fn(struct k_work* work);
+K_WORK_DELAYABLE_DEFINE(trace_stream_work, trace_stream_fn);
+
+static void trace_stream_fn(struct k_work* work)
+{
+	struct edge_trace_entry e;
+	uint8_t rec[12];
+	atomic_val_t head = atomic_get(&edge_trace_head);
+
+	ARG_UNUSED(work);
+	if (head - trace_stream_next > EDGE_TRACE_LEN) {
+		trace_stream_next = head - EDGE_TRACE_LEN;  // we fell behind, skip what is gone
+	}
+	for (; trace_stream_next < head; trace_stream_next++) {
+		if (edge_trace_get(trace_stream_next, &e)) {
+			edge_trace_pack(trace_stream_next, &e, rec);
+			shell_hexdump_line(trace_stream_sh, 0, rec, sizeof(rec));
+		}
+	}
+	if (atomic_get(&trace_stream_on)) {
+		k_work_schedule(&trace_stream_work, K_MSEC(100));
+	}
+}
+
+static int cmd_trace_stream(const struct shell* sh, size_t argc, char** argv)
+{
+	struct k_work_sync sync;
+
+	ARG_UNUSED(argc);
+
+	if (strcmp(argv[1], "on") == 0) {
+		if (atomic_cas(&trace_stream_on, 0, 1)) {
+			trace_stream_sh = sh;
+			trace_stream_next = atomic_get(&edge_trace_head);
+			k_work_schedule(&trace_stream_work, K_NO_WAIT);
+		}
+	} else if (strcmp(argv[1], "off") == 0) {
+		/* Clear the flag first, so a run that is in progress does not reschedule. */
+		atomic_clear(&trace_stream_on);
+		k_work_cancel_delayable_sync(&trace_stream_work, &sync);
+	} else {
+		shell_error(sh, "stream on|off");
+		return -EINVAL;
+	}
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_trace,
+	SHELL_CMD_ARG(dump, NULL, "Last edges as text: dump [n]", cmd_trace_dump, 1, 1),
+	SHELL_CMD_ARG(bin, NULL, "Last edges as packed 12-byte records: bin [n]", cmd_trace_bin, 1, 1),
+	SHELL_CMD_ARG(stream, NULL, "Print new edges every 100 ms: stream on|off", cmd_trace_stream, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_SUBCMD_ADD((morse), trace, &sub_trace, "LED edge trace", NULL, 2, 1);
+
+#endif /* EDGE_TRACE_H */
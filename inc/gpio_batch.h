@@ -0,0 +1,101 @@
+#ifndef GPIO_BATCH_H
+#define GPIO_BATCH_H
+
+#include <zephyr/drivers/gpio.h>  // gpio_port_set_masked(), struct gpio_dt_spec
+
+/*
+ * Batched GPIO writes.
+ *
+ * gpio_pin_set_dt() is one driver call per LED, so 4 LEDs that "switch at the
+ * same time" really switch one after the other. A batch collects the changes
+ * per GPIO controller (port) and then writes each port ONCE with
+ * gpio_port_set_masked(): all pins on a port change in the same instant.
+ *
+ *   struct gpio_batch b = {0};
+ *   gpio_batch_set_dt(&b, led0, true);
+ *   gpio_batch_set_dt(&b, led1, false);
+ *   gpio_batch_flush(&b);   // one write per port
+ *
+ * gpio_port_set_masked() uses logical levels, so GPIO_ACTIVE_LOW LEDs behave
+ * exactly like with gpio_pin_set_dt().
+ */
+
+#ifndef GPIO_BATCH_MAX_PORTS
+#define GPIO_BATCH_MAX_PORTS 4  // raise it (before including) for LEDs spread over more controllers
+#endif
+
+struct gpio_batch_port {
+	const struct device* port;  // GPIO controller
+	gpio_port_pins_t mask;      // pins changed since the last flush
+	gpio_port_value_t value;    // new levels of those pins
+};
+
+struct gpio_batch {
+	struct gpio_batch_port ports[GPIO_BATCH_MAX_PORTS];
+	size_t num_ports;
+};
+
+int gpio_batch_add(struct gpio_batch* b, const struct gpio_dt_spec* spec) {
+	// Find (or make) the slot for the port this pin is on.
+	// Look it up once and keep it if you set the same pin often.
+	// Returns: slot index, or -ENOMEM if there are too many ports.
+
+	for (size_t idx = 0; idx < b->num_ports; idx++) {
+		if (b->ports[idx].port == spec->port) {
+			return (int)idx;
+		}
+	}
+
+	if (b->num_ports == GPIO_BATCH_MAX_PORTS) {
+		return -ENOMEM;
+	}
+	b->ports[b->num_ports].port = spec->port;
+	b->ports[b->num_ports].mask = 0;
+	b->ports[b->num_ports].value = 0;
+	return (int)b->num_ports++;
+}
+
+/* Queue one pin change on an already known slot (no searching). */
+static inline void gpio_batch_set_pin(struct gpio_batch* b, uint8_t slot, gpio_pin_t pin, bool on)
+{
+	gpio_port_pins_t bit = BIT(pin);
+
+	b->ports[slot].mask |= bit;
+	b->ports[slot].value = (b->ports[slot].value & ~bit) | (on ? bit : 0U);
+}
+
+int gpio_batch_set_dt(struct gpio_batch* b, const struct gpio_dt_spec* spec, bool on) {
+	// Queue one pin change, looking up its port.
+	// Returns: 0, or -ENOMEM if there are too many ports.
+
+	int slot = gpio_batch_add(b, spec);
+	if (slot < 0) {
+		return slot;
+	}
+	gpio_batch_set_pin(b, (uint8_t)slot, spec->pin, on);
+	return 0;
+}
+
+int gpio_batch_flush(struct gpio_batch* b) {
+	// Write every port that has pending changes (one driver call each).
+	// Returns: 0 on success, or the first negative error code from the driver.
+
+	int ret = 0;
+
+	for (size_t idx = 0; idx < b->num_ports; idx++) {
+		struct gpio_batch_port* p = &b->ports[idx];
+		if (p->mask == 0U) {
+			continue;  // nothing changed on this port
+		}
+
+		int err = gpio_port_set_masked(p->port, p->mask, p->value);
+		if (err < 0 && ret == 0) {
+			ret = err;
+		}
+		p->mask = 0;
+	}
+
+	return ret;
+}
+
+#endif /* GPIO_BATCH_H */
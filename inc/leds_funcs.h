@@ -1,5 +1,9 @@
+#ifndef LEDS_FUNCS_H
+#define LEDS_FUNCS_H
+
 #include <stdio.h>
 #include <zephyr/drivers/gpio.h>   // Zephyr GPIO types/functions (LED pins are GPIOs)
+#include <gpio_batch.h>            // gpio_batch_*(): one write per GPIO port
 
 int setup_leds(const struct gpio_dt_spec* arr_gds_leds[], size_t num_leds) {
 	// This function "prepares" a list of LEDs so we can turn them on/off later.
@@ -29,7 +33,16 @@ void set_leds(const struct gpio_dt_spec* arr_gds_leds[], size_t num_leds, bool I
 	// This function turns ALL LEDs in the list ON or OFF.
 	//
 	// IS_ON = true -> turn on, false -> turn off
+	//
+	// LEDs on the same GPIO port change together in one masked port write.
+	struct gpio_batch batch = {0};
+
 	for (size_t idx = 0; idx < num_leds; idx++) {       // for each LED...
-		gpio_pin_set_dt(arr_gds_leds[idx], IS_ON);        // set its output level (1=on, 0=off)
+		if (gpio_batch_set_dt(&batch, arr_gds_leds[idx], IS_ON) < 0) {
+			gpio_pin_set_dt(arr_gds_leds[idx], IS_ON);  // too many ports: set it directly
+		}
 	}
-}
\ No newline at end of file
+	gpio_batch_flush(&batch);                           // one write per port
+}
+
+#endif /* LEDS_FUNCS_H */
\ No newline at end of file
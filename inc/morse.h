@@ -0,0 +1,253 @@
+#ifndef MORSE_H
+#define MORSE_H
+
+#include <stdint.h>   // uint8_t
+#include <stddef.h>   // size_t
+#include <errno.h>    // EINVAL, ENOMEM
+
+/*
+ * ASCII -> International (ITU) Morse lookup.
+ *
+ * Each character is ONE byte in morse_table[]:
+ *   - bit 0 is the first element, bit 1 the second, ...  (1 = dash, 0 = dot)
+ *   - one extra "1" bit (the sentinel) sits just above the last element,
+ *     so the element count is implied by where the highest 1 bit is.
+ *
+ * Example: 'G' = --.  -> elements (first..last) 1,1,0 + sentinel -> 0b1011 = 0x0B
+ *
+ * So sending a letter is just "look at bit 0, shift right" until only the
+ * sentinel is left. 8 bits = sentinel + up to 7 elements, which covers every
+ * ITU letter, digit and punctuation mark ('$' is the longest at 7).
+ * The 8-element <HH> "error" and <SOS> do not fit; send them as letters.
+ *
+ * Special values:
+ *   MORSE_CODE_NONE  (0x00) = character has no Morse code (skip it)
+ *   MORSE_CODE_SPACE (0x01) = word space (sentinel only, zero elements)
+ */
+#define MORSE_CODE_NONE  0x00
+#define MORSE_CODE_SPACE 0x01
+
+#define MORSE_MAX_ELEMENTS 7
+
+/* Timing in units of T (the dot length). */
+#define MORSE_DOT_UNITS         1U
+#define MORSE_DASH_UNITS        3U
+#define MORSE_SYMBOL_GAP_UNITS  1U  // between dots/dashes of one letter
+#define MORSE_LETTER_GAP_UNITS  3U  // between letters
+#define MORSE_WORD_GAP_UNITS    7U  // between words (and after the last word)
+
+/*
+ * Prosigns that are not already a punctuation mark live on unused ASCII
+ * control codes, so they can be put straight into a string ("\x04" = <SK>).
+ * <AR>, <BT>, <KN> and <AS> are the same codes as '+', '=', '(' and '&'.
+ */
+#define MORSE_PROSIGN_CT 0x02  // -.-.-   start of transmission (STX)
+#define MORSE_PROSIGN_SK 0x04  // ...-.-  end of contact (EOT)
+#define MORSE_PROSIGN_SN 0x06  // ...-.   understood (ACK)
+#define MORSE_PROSIGN_AR '+'   // .-.-.   end of message
+#define MORSE_PROSIGN_BT '='   // -...-   break
+#define MORSE_PROSIGN_KN '('   // -.--.   go ahead, named station only
+#define MORSE_PROSIGN_AS '&'   // .-...   wait
+
+/*
+ * The chart (ITU-R M.1677-1), written down once: one macro per character
+ * with its elements first to last, DIT (dot) or DAH (dash). morse_table[]
+ * below and the build-time timelines of morse_timeline.h are both made from
+ * it. The names are what MORSE_TIMELINE() takes: letters, digits, a word
+ * for each punctuation mark, and the prosigns.
+ */
+#define MORSE_CHART_A DIT, DAH                       /* .-      */
+#define MORSE_CHART_B DAH, DIT, DIT, DIT             /* -...    */
+#define MORSE_CHART_C DAH, DIT, DAH, DIT             /* -.-.    */
+#define MORSE_CHART_D DAH, DIT, DIT                  /* -..     */
+#define MORSE_CHART_E DIT                            /* .       */
+#define MORSE_CHART_F DIT, DIT, DAH, DIT             /* ..-.    */
+#define MORSE_CHART_G DAH, DAH, DIT                  /* --.     */
+#define MORSE_CHART_H DIT, DIT, DIT, DIT             /* ....    */
+#define MORSE_CHART_I DIT, DIT                       /* ..      */
+#define MORSE_CHART_J DIT, DAH, DAH, DAH             /* .---    */
+#define MORSE_CHART_K DAH, DIT, DAH                  /* -.-     */
+#define MORSE_CHART_L DIT, DAH, DIT, DIT             /* .-..    */
+#define MORSE_CHART_M DAH, DAH                       /* --      */
+#define MORSE_CHART_N DAH, DIT                       /* -.      */
+#define MORSE_CHART_O DAH, DAH, DAH                  /* ---     */
+#define MORSE_CHART_P DIT, DAH, DAH, DIT             /* .--.    */
+#define MORSE_CHART_Q DAH, DAH, DIT, DAH             /* --.-    */
+#define MORSE_CHART_R DIT, DAH, DIT                  /* .-.     */
+#define MORSE_CHART_S DIT, DIT, DIT                  /* ...     */
+#define MORSE_CHART_T DAH                            /* -       */
+#define MORSE_CHART_U DIT, DIT, DAH                  /* ..-     */
+#define MORSE_CHART_V DIT, DIT, DIT, DAH             /* ...-    */
+#define MORSE_CHART_W DIT, DAH, DAH                  /* .--     */
+#define MORSE_CHART_X DAH, DIT, DIT, DAH             /* -..-    */
+#define MORSE_CHART_Y DAH, DIT, DAH, DAH             /* -.--    */
+#define MORSE_CHART_Z DAH, DAH, DIT, DIT             /* --..    */
+#define MORSE_CHART_0 DAH, DAH, DAH, DAH, DAH        /* -----   */
+#define MORSE_CHART_1 DIT, DAH, DAH, DAH, DAH        /* .----   */
+#define MORSE_CHART_2 DIT, DIT, DAH, DAH, DAH        /* ..---   */
+#define MORSE_CHART_3 DIT, DIT, DIT, DAH, DAH        /* ...--   */
+#define MORSE_CHART_4 DIT, DIT, DIT, DIT, DAH        /* ....-   */
+#define MORSE_CHART_5 DIT, DIT, DIT, DIT, DIT        /* .....   */
+#define MORSE_CHART_6 DAH, DIT, DIT, DIT, DIT        /* -....   */
+#define MORSE_CHART_7 DAH, DAH, DIT, DIT, DIT        /* --...   */
+#define MORSE_CHART_8 DAH, DAH, DAH, DIT, DIT        /* ---..   */
+#define MORSE_CHART_9 DAH, DAH, DAH, DAH, DIT        /* ----.   */
+#define MORSE_CHART_PERIOD DIT, DAH, DIT, DAH, DIT, DAH      /* .-.-.-  . */
+#define MORSE_CHART_COMMA DAH, DAH, DIT, DIT, DAH, DAH       /* --..--  , */
+#define MORSE_CHART_QUESTION DIT, DIT, DAH, DAH, DIT, DIT    /* ..--..  ? */
+#define MORSE_CHART_APOSTROPHE DIT, DAH, DAH, DAH, DAH, DIT  /* .----.  ' */
+#define MORSE_CHART_EXCLAMATION DAH, DIT, DAH, DIT, DAH, DAH /* -.-.--  ! */
+#define MORSE_CHART_SLASH DAH, DIT, DIT, DAH, DIT            /* -..-.   / */
+#define MORSE_CHART_PAREN_OPEN DAH, DIT, DAH, DAH, DIT       /* -.--.   ( */
+#define MORSE_CHART_PAREN_CLOSE DAH, DIT, DAH, DAH, DIT, DAH /* -.--.-  ) */
+#define MORSE_CHART_AMPERSAND DIT, DAH, DIT, DIT, DIT        /* .-...   & */
+#define MORSE_CHART_COLON DAH, DAH, DAH, DIT, DIT, DIT       /* ---...  : */
+#define MORSE_CHART_SEMICOLON DAH, DIT, DAH, DIT, DAH, DIT   /* -.-.-.  ; */
+#define MORSE_CHART_EQUALS DAH, DIT, DIT, DIT, DAH           /* -...-   = */
+#define MORSE_CHART_PLUS DIT, DAH, DIT, DAH, DIT             /* .-.-.   + */
+#define MORSE_CHART_HYPHEN DAH, DIT, DIT, DIT, DIT, DAH      /* -....-  - */
+#define MORSE_CHART_UNDERSCORE DIT, DIT, DAH, DAH, DIT, DAH  /* ..--.-  _ */
+#define MORSE_CHART_QUOTE DIT, DAH, DIT, DIT, DAH, DIT       /* .-..-.  " */
+#define MORSE_CHART_DOLLAR DIT, DIT, DIT, DAH, DIT, DIT, DAH /* ...-..- $ */
+#define MORSE_CHART_AT DIT, DAH, DAH, DIT, DAH, DIT          /* .--.-.  @ */
+#define MORSE_CHART_CT DAH, DIT, DAH, DIT, DAH               /* -.-.-   <CT> */
+#define MORSE_CHART_SK DIT, DIT, DIT, DAH, DIT, DAH          /* ...-.-  <SK> */
+#define MORSE_CHART_SN DIT, DIT, DIT, DAH, DIT               /* ...-.   <SN> */
+#define MORSE_CHART_AR MORSE_CHART_PLUS
+#define MORSE_CHART_BT MORSE_CHART_EQUALS
+#define MORSE_CHART_KN MORSE_CHART_PAREN_OPEN
+#define MORSE_CHART_AS MORSE_CHART_AMPERSAND
+
+/* The character of every chart entry, as fn(name, character). */
+#define MORSE_CHART_LETTERS(fn) \
+	fn(A, 'A') fn(B, 'B') fn(C, 'C') fn(D, 'D') fn(E, 'E') fn(F, 'F') fn(G, 'G') \
+	fn(H, 'H') fn(I, 'I') fn(J, 'J') fn(K, 'K') fn(L, 'L') fn(M, 'M') fn(N, 'N') \
+	fn(O, 'O') fn(P, 'P') fn(Q, 'Q') fn(R, 'R') fn(S, 'S') fn(T, 'T') fn(U, 'U') \
+	fn(V, 'V') fn(W, 'W') fn(X, 'X') fn(Y, 'Y') fn(Z, 'Z')
+
+#define MORSE_CHART_OTHERS(fn) \
+	fn(0, '0') fn(1, '1') fn(2, '2') fn(3, '3') fn(4, '4') \
+	fn(5, '5') fn(6, '6') fn(7, '7') fn(8, '8') fn(9, '9') \
+	fn(PERIOD, '.') fn(COMMA, ',') fn(QUESTION, '?') fn(APOSTROPHE, '\'') \
+	fn(EXCLAMATION, '!') fn(SLASH, '/') fn(PAREN_OPEN, '(') fn(PAREN_CLOSE, ')') \
+	fn(AMPERSAND, '&') fn(COLON, ':') fn(SEMICOLON, ';') fn(EQUALS, '=') \
+	fn(PLUS, '+') fn(HYPHEN, '-') fn(UNDERSCORE, '_') fn(QUOTE, '"') \
+	fn(DOLLAR, '$') fn(AT, '@') \
+	fn(CT, MORSE_PROSIGN_CT) fn(SK, MORSE_PROSIGN_SK) fn(SN, MORSE_PROSIGN_SN)
+
+/*
+ * Chart helpers. A chart entry is a list of 1 to 7 elements; Z_MORSE_CHART()
+ * calls prefix##<how many> with them, so each of those macros only has to
+ * deal with one length (and hands the rest on to the one below it).
+ */
+#define Z_MORSE_CAT(a, b) Z_MORSE_CAT_(a, b)
+#define Z_MORSE_CAT_(a, b) a##b
+#define Z_MORSE_CALL(m, ...) m(__VA_ARGS__)
+#define Z_MORSE_COUNT(...) Z_MORSE_COUNT_(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0)
+#define Z_MORSE_COUNT_(e1, e2, e3, e4, e5, e6, e7, n, ...) n
+#define Z_MORSE_CHART(prefix, name) \
+	Z_MORSE_CALL(Z_MORSE_CAT(prefix, Z_MORSE_COUNT(MORSE_CHART_##name)), MORSE_CHART_##name)
+
+#define Z_MORSE_BIT_DIT 0U
+#define Z_MORSE_BIT_DAH 1U
+
+/* Packed code: first element in bit 0, the sentinel above the last. */
+#define Z_MORSE_PACK_1(a) (2U | Z_MORSE_BIT_##a)
+#define Z_MORSE_PACK_2(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_1(__VA_ARGS__) << 1))
+#define Z_MORSE_PACK_3(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_2(__VA_ARGS__) << 1))
+#define Z_MORSE_PACK_4(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_3(__VA_ARGS__) << 1))
+#define Z_MORSE_PACK_5(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_4(__VA_ARGS__) << 1))
+#define Z_MORSE_PACK_6(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_5(__VA_ARGS__) << 1))
+#define Z_MORSE_PACK_7(a, ...) (Z_MORSE_BIT_##a | (Z_MORSE_PACK_6(__VA_ARGS__) << 1))
+
+/* Packed code of a chart entry, as a constant expression: MORSE_PACK(G) == 0x0B */
+#define MORSE_PACK(name) Z_MORSE_CHART(Z_MORSE_PACK_, name)
+
+#define Z_MORSE_TABLE_LETTER(name, upper) \
+	[upper] = MORSE_PACK(name), [(upper) - 'A' + 'a'] = MORSE_PACK(name),
+#define Z_MORSE_TABLE_OTHER(name, c) [c] = MORSE_PACK(name),
+
+/* Upper and lower case are the same. */
+const uint8_t morse_table[128] = {
+	[' '] = MORSE_CODE_SPACE,
+	MORSE_CHART_LETTERS(Z_MORSE_TABLE_LETTER)
+	MORSE_CHART_OTHERS(Z_MORSE_TABLE_OTHER)
+};
+
+uint8_t morse_lookup(char c) {
+	// Returns the packed code for c (see top of file), or MORSE_CODE_NONE.
+	// Non-ASCII bytes (>= 128) have no code.
+	unsigned char uc = (unsigned char)c;
+	return (uc < 128U) ? morse_table[uc] : MORSE_CODE_NONE;
+}
+
+size_t morse_code_len(uint8_t code) {
+	// How many dots/dashes are in a packed code (0 for NONE and SPACE).
+	size_t len = 0;
+	while (code > 1U) {  // stop when only the sentinel is left
+		code >>= 1;
+		len++;
+	}
+	return len;
+}
+
+char morse_char(uint8_t code) {
+	// The other way round: packed code -> character, 0 if no character has it.
+	// Upper case wins over lower case and the first character over aliases
+	// (a plain search, so only for the odd letter; morse_rx.h keeps a table).
+	if (code <= MORSE_CODE_SPACE) {
+		return 0;
+	}
+	for (size_t c = 0; c < sizeof(morse_table); c++) {
+		if (morse_table[c] == code) {
+			return (char)c;
+		}
+	}
+	return 0;
+}
+
+int morse_encode_units(const char* text, uint8_t* units, size_t max_units) {
+	// Turns a whole string into an ON/OFF timeline measured in units of T.
+	//   units[0] = ON, units[1] = OFF, units[2] = ON, ...  (always ON/OFF pairs)
+	// Letter gaps (3T) and word gaps (7T) are folded into the OFF entries, and the
+	// last OFF is the 7T word gap, so the timeline can be repeated back-to-back.
+	// Returns: number of entries written, -EINVAL if text has nothing to send,
+	//          -ENOMEM if units[] is too small.
+
+	size_t n = 0;  // entries written so far
+
+	for (size_t i = 0; text[i] != '\0'; i++) {
+		uint8_t code = morse_lookup(text[i]);
+
+		if (code == MORSE_CODE_SPACE) {
+			if (n > 0) {
+				units[n - 1] = MORSE_WORD_GAP_UNITS;  // stretch the previous gap
+			}
+			continue;
+		}
+		if (code == MORSE_CODE_NONE) {
+			continue;  // nothing to send for this character
+		}
+
+		if (n > 0 && units[n - 1] == MORSE_SYMBOL_GAP_UNITS) {
+			units[n - 1] = MORSE_LETTER_GAP_UNITS;  // previous element ended a letter
+		}
+
+		while (code > 1U) {
+			if (n + 2 > max_units) {
+				return -ENOMEM;
+			}
+			units[n++] = (code & 1U) ? MORSE_DASH_UNITS : MORSE_DOT_UNITS;
+			units[n++] = MORSE_SYMBOL_GAP_UNITS;
+			code >>= 1;
+		}
+	}
+
+	if (n == 0) {
+		return -EINVAL;
+	}
+	units[n - 1] = MORSE_WORD_GAP_UNITS;  // gap before the timeline repeats
+	return (int)n;
+}
+
+#endif /* MORSE_H */
@@ -0,0 +1,242 @@
+#ifndef MORSE_BENCH_H
+#define MORSE_BENCH_H
+
+/*
+ * Benchmark harness (only built with -DMORSE_BENCH=ON, see CMakeLists.txt).
+ *
+ * This header is force-included (gcc -include) in front of whichever main_*.c
+ * is being built, so the variants do not have to change at all:
+ *   - gpio_pin_set_dt() and gpio_port_set_masked() are wrapped, and every
+ *     real LED transition is stored with its timestamp;
+ *   - a bench thread waits MORSE_BENCH_SECONDS, then prints one report.
+ *
+ * Report (every line starts with "BENCH" so scripts/bench.sh can grep it):
+ *   jitter  = how far each ON/OFF interval is from a whole number of grid
+ *             units (MORSE_BENCH_GRID_MS), percentiles over all edges
+ *   drift   = per LED, how far the last edge is from where the ideal grid
+ *             (started at that LED's first edge) says it should be
+ *   cpu     = execution time per thread (thread runtime stats)
+ *   stack   = stack high-water mark per thread
+ *   wakeups = times the CPU left idle, per second
+ *   cpuN    = busy share of each CPU over the run (SMP builds, see morse_smp.h)
+ * ROM/RAM footprint comes from the build itself (scripts/bench.sh).
+ *
+ * The grid default of 50 ms divides the timing of every variant (Morse T =
+ * 150 ms, plain blinky 50/150/200 ms).
+ */
+
+#include <stdlib.h>               // qsort()
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+
+#ifndef MORSE_BENCH_VARIANT
+#define MORSE_BENCH_VARIANT "unknown"
+#endif
+
+#ifndef MORSE_BENCH_SECONDS
+#define MORSE_BENCH_SECONDS 60
+#endif
+
+#ifndef MORSE_BENCH_GRID_MS
+#define MORSE_BENCH_GRID_MS 50
+#endif
+
+#define MORSE_BENCH_MAX_EDGES 8192
+#define MORSE_BENCH_MAX_CHANS 64
+
+struct morse_bench_edge {
+	int64_t t;         // tick of the transition
+	uint8_t chan;      // index into bench_pins[]
+};
+
+static struct morse_bench_edge bench_edges[MORSE_BENCH_MAX_EDGES];
+static size_t bench_num_edges;
+static struct k_spinlock bench_lock;  // edges come from threads and timer ISRs
+
+/* Every (port, pin) we have seen gets a channel number, in order of first use. */
+static struct {
+	const struct device* port;
+	gpio_pin_t pin;
+	int level;
+} bench_pins[MORSE_BENCH_MAX_CHANS];
+static size_t bench_num_pins;
+
+static uint32_t bench_idle_entries;  // CPU went idle (each one ends in a wakeup)
+static uint32_t bench_isrs;          // interrupts taken
+
+/* Record one pin change if it really is a transition. */
+static void morse_bench_record(const struct device* port, gpio_pin_t pin, int level)
+{
+	k_spinlock_key_t key = k_spin_lock(&bench_lock);
+	size_t ch;
+
+	for (ch = 0; ch < bench_num_pins; ch++) {
+		if (bench_pins[ch].port == port && bench_pins[ch].pin == pin) {
+			break;
+		}
+	}
+	if (ch == bench_num_pins) {
+		if (ch == MORSE_BENCH_MAX_CHANS) {
+			k_spin_unlock(&bench_lock, key);
+			return;
+		}
+		bench_pins[ch].port = port;
+		bench_pins[ch].pin = pin;
+		bench_pins[ch].level = -1;
+		bench_num_pins++;
+	}
+
+	if (bench_pins[ch].level != level) {
+		bench_pins[ch].level = level;
+		if (bench_num_edges < MORSE_BENCH_MAX_EDGES) {
+			bench_edges[bench_num_edges].t = k_uptime_ticks();
+			bench_edges[bench_num_edges].chan = (uint8_t)ch;
+			bench_num_edges++;
+		}
+	}
+	k_spin_unlock(&bench_lock, key);
+}
+
+static inline int morse_bench_pin_set_dt(const struct gpio_dt_spec* spec, int value)
+{
+	morse_bench_record(spec->port, spec->pin, value != 0);
+	return gpio_pin_set_dt(spec, value);
+}
+
+static inline int morse_bench_port_set_masked(const struct device* port, gpio_port_pins_t mask,
+                                              gpio_port_value_t value)
+{
+	for (gpio_pin_t pin = 0; pin < 32U && (mask >> pin) != 0U; pin++) {
+		if ((mask >> pin) & 1U) {
+			morse_bench_record(port, pin, (value >> pin) & 1U);
+		}
+	}
+	return gpio_port_set_masked(port, mask, value);
+}
+
+/* From here on every LED write in the variant goes through the recorder. */
+#define gpio_pin_set_dt(spec, value) morse_bench_pin_set_dt((spec), (value))
+#define gpio_port_set_masked(port, mask, value) morse_bench_port_set_masked((port), (mask), (value))
+
+/* Tracing hooks (CONFIG_TRACING_USER): count idle entries and interrupts. */
+void sys_trace_idle_user(void)
+{
+	bench_idle_entries++;
+}
+
+void sys_trace_isr_enter_user(int nested_interrupts)
+{
+	ARG_UNUSED(nested_interrupts);
+	bench_isrs++;
+}
+
+static int bench_cmp_u32(const void* a, const void* b)
+{
+	uint32_t x = *(const uint32_t*)a;
+	uint32_t y = *(const uint32_t*)b;
+	return (x > y) - (x < y);
+}
+
+static uint32_t bench_jitter_us[MORSE_BENCH_MAX_EDGES];
+
+static void bench_thread_report(const struct k_thread* cthread, void* user_data)
+{
+	struct k_thread* thread = (struct k_thread*)cthread;
+	k_thread_runtime_stats_t stats;
+	size_t unused = 0;
+	const char* name = k_thread_name_get(thread);
+
+	ARG_UNUSED(user_data);
+	k_thread_runtime_stats_get(thread, &stats);
+	k_thread_stack_space_get(thread, &unused);
+
+	printk("BENCH thread %-12s %p cpu_us=%u stack_used=%u/%u\n",
+	       (name != NULL && name[0] != '\0') ? name : "-", (void*)thread,
+	       (uint32_t)k_cyc_to_us_near64(stats.execution_cycles),
+	       (uint32_t)(thread->stack_info.size - unused), (uint32_t)thread->stack_info.size);
+}
+
+static void morse_bench_report(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&bench_lock);
+	size_t n = bench_num_edges;  // only look at the edges of the measured run
+	k_spin_unlock(&bench_lock, key);
+
+	k_ticks_t grid = k_ms_to_ticks_ceil64(MORSE_BENCH_GRID_MS);
+	size_t num_jitter = 0;
+
+	printk("BENCH variant=%s seconds=%u grid_ms=%u edges=%u chans=%u\n", MORSE_BENCH_VARIANT,
+	       MORSE_BENCH_SECONDS, MORSE_BENCH_GRID_MS, (unsigned)n, (unsigned)bench_num_pins);
+
+	/* Per LED: jitter of every interval, drift of the last edge. */
+	for (size_t ch = 0; ch < bench_num_pins; ch++) {
+		int64_t first = -1;
+		int64_t prev = 0;
+		int64_t grid_units = 0;  // whole grid units between first and last edge
+
+		for (size_t i = 0; i < n; i++) {
+			if (bench_edges[i].chan != ch) {
+				continue;
+			}
+			int64_t t = bench_edges[i].t;
+			if (first < 0) {
+				first = t;
+			} else {
+				int64_t interval = t - prev;
+				int64_t units = (interval + grid / 2) / grid;  // nearest whole unit
+				int64_t err = interval - units * grid;
+
+				grid_units += units;
+				bench_jitter_us[num_jitter++] = (uint32_t)k_ticks_to_us_near64(err < 0 ? -err : err);
+			}
+			prev = t;
+		}
+
+		if (first >= 0) {
+			int64_t drift = (prev - first) - grid_units * grid;
+			printk("BENCH drift ch%u drift_us=%d\n", (unsigned)ch,
+			       (int)((drift < 0) ? -(int64_t)k_ticks_to_us_near64(-drift)
+			                         : (int64_t)k_ticks_to_us_near64(drift)));
+		}
+	}
+
+	if (num_jitter > 0) {
+		qsort(bench_jitter_us, num_jitter, sizeof(bench_jitter_us[0]), bench_cmp_u32);
+		printk("BENCH jitter_us p50=%u p90=%u p99=%u max=%u\n",
+		       bench_jitter_us[num_jitter * 50 / 100], bench_jitter_us[num_jitter * 90 / 100],
+		       bench_jitter_us[num_jitter * 99 / 100], bench_jitter_us[num_jitter - 1]);
+	}
+
+	printk("BENCH wakeups total=%u per_s=%u isrs=%u\n", bench_idle_entries,
+	       bench_idle_entries / MORSE_BENCH_SECONDS, bench_isrs);
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		k_thread_runtime_stats_t rt;
+		if (k_thread_runtime_stats_cpu_get(cpu, &rt) == 0) {
+			uint64_t all = rt.total_cycles + rt.idle_cycles;
+			printk("BENCH cpu%d busy_permille=%u\n", cpu,
+			       (all != 0U) ? (uint32_t)(rt.total_cycles * 1000U / all) : 0U);
+		}
+	}
+#endif
+
+	k_thread_foreach(bench_thread_report, NULL);
+	printk("BENCH done\n");
+}
+
+static void morse_bench_thread(void* p1, void* p2, void* p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_SECONDS(MORSE_BENCH_SECONDS));
+	morse_bench_report();
+}
+
+/* Lowest priority, so it never gets in the way of the variant being measured. */
+K_THREAD_DEFINE(morse_bench_tid, 2048, morse_bench_thread, NULL, NULL, NULL,
+                K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+#endif /* MORSE_BENCH_H */
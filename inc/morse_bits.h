@@ -0,0 +1,176 @@
+#ifndef MORSE_BITS_H
+#define MORSE_BITS_H
+
+#include <stdint.h>   // uint8_t
+#include <stddef.h>   // size_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memset()
+#include <errno.h>    // EINVAL, ENOMEM
+#include <morse.h>    // morse_lookup(), MORSE_*_UNITS
+
+/*
+ * Bit-packed Morse: ONE BIT PER TIME UNIT T.
+ *
+ *   1 = LED on for this unit, 0 = LED off for this unit
+ *   bits are stored MSB first: bit 0 of the message is (byte[0] >> 7) & 1
+ *
+ *   "is" = ..  ...  -> 1010001010100000 00  (18 bits, last 7 zeros = word gap)
+ *        -> 3 bytes instead of a timeline of 10 bytes or pattern strings
+ *
+ * The message always ends with the 7T word gap, so it can loop forever.
+ * Its length is the number of BITS (nbits), the bytes are (nbits + 7) / 8.
+ *
+ * A player never needs the whole message: morse_bits_next_run() returns the
+ * next ON or OFF run ("on for 3 units"), walking the bits with shifts and
+ * skipping whole 0x00 / 0xFF bytes at once. Messages can come from RAM, from
+ * flash, or piece by piece from anywhere through a fetch() callback.
+ */
+
+#define MORSE_BITS_BYTES(nbits) (((nbits) + 7U) / 8U)
+
+/* Most bits one character can need: 7 dashes with their gaps + a word gap before it. */
+#define MORSE_BITS_MAX_PER_CHAR \
+	(MORSE_MAX_ELEMENTS * (MORSE_DASH_UNITS + MORSE_SYMBOL_GAP_UNITS) + MORSE_WORD_GAP_UNITS)
+
+/* Append count copies of one bit at bit position *nbits (buffer must start zeroed). */
+static inline int morse_bits_put(uint8_t* buf, size_t buf_len, size_t* nbits, bool on, uint32_t count)
+{
+	if (*nbits + count > buf_len * 8U) {
+		return -ENOMEM;
+	}
+	if (on) {
+		for (uint32_t i = 0; i < count; i++) {
+			size_t pos = *nbits + i;
+			buf[pos >> 3] |= (uint8_t)(0x80U >> (pos & 7U));
+		}
+	}
+	*nbits += count;
+	return 0;
+}
+
+int morse_bits_encode(const char* text, uint8_t* buf, size_t buf_len) {
+	// Encodes text as a bitstream (same gaps as morse_encode_units()).
+	// Returns: number of bits written, -EINVAL if text has nothing to send,
+	//          -ENOMEM if buf is too small.
+
+	size_t nbits = 0;
+	uint32_t gap_units = 0;  // OFF time owed before the next letter
+	int ret;
+
+	memset(buf, 0, buf_len);
+
+	for (size_t i = 0; text[i] != '\0'; i++) {
+		uint8_t code = morse_lookup(text[i]);
+
+		if (code == MORSE_CODE_SPACE) {
+			if (gap_units != 0U) {
+				gap_units = MORSE_WORD_GAP_UNITS;
+			}
+			continue;
+		}
+		if (code == MORSE_CODE_NONE) {
+			continue;
+		}
+
+		ret = morse_bits_put(buf, buf_len, &nbits, false, gap_units);
+		while (ret == 0 && code > 1U) {
+			ret = morse_bits_put(buf, buf_len, &nbits, true, (code & 1U) ? MORSE_DASH_UNITS : MORSE_DOT_UNITS);
+			code >>= 1;
+			if (ret == 0 && code > 1U) {
+				ret = morse_bits_put(buf, buf_len, &nbits, false, MORSE_SYMBOL_GAP_UNITS);
+			}
+		}
+		if (ret < 0) {
+			return ret;
+		}
+		gap_units = MORSE_LETTER_GAP_UNITS;
+	}
+
+	if (nbits == 0) {
+		return -EINVAL;
+	}
+	ret = morse_bits_put(buf, buf_len, &nbits, false, MORSE_WORD_GAP_UNITS);
+	return (ret < 0) ? ret : (int)nbits;
+}
+
+/*
+ * Streaming reader.
+ *
+ * The bits come in chunks. A message in memory is just one chunk; other
+ * sources (flash pages, a UART) hand out the next chunk from fetch(), which
+ * returns NULL when the message is over. The chunk is read in place, never copied.
+ */
+struct morse_bits_reader {
+	const uint8_t* chunk;   // bytes being read now
+	size_t chunk_bits;      // valid bits in chunk
+	size_t pos;             // next bit in chunk
+	const uint8_t* (*fetch)(void* ctx, size_t* num_bits);  // next chunk, or NULL (optional)
+	void* ctx;              // passed to fetch()
+	const uint8_t* first;   // first chunk, for morse_bits_rewind()
+	size_t first_bits;
+};
+
+void morse_bits_reader_init(struct morse_bits_reader* rd, const uint8_t* bits, size_t nbits,
+                            const uint8_t* (*fetch)(void* ctx, size_t* num_bits), void* ctx) {
+	// Start reading at bit 0 of bits[]; fetch may be NULL for a message that is all in memory.
+	rd->chunk = bits;
+	rd->chunk_bits = nbits;
+	rd->pos = 0;
+	rd->fetch = fetch;
+	rd->ctx = ctx;
+	rd->first = bits;
+	rd->first_bits = nbits;
+}
+
+void morse_bits_rewind(struct morse_bits_reader* rd) {
+	// Go back to the first chunk (for looping a message). A fetch() source has
+	// to restart itself as well, this only resets the reader.
+	rd->chunk = rd->first;
+	rd->chunk_bits = rd->first_bits;
+	rd->pos = 0;
+}
+
+uint32_t morse_bits_next_run(struct morse_bits_reader* rd, bool* on) {
+	// Returns how many units the next run lasts and its level in *on.
+	// Returns 0 at the end of the message.
+
+	uint32_t run = 0;
+	unsigned level = 2U;  // not known until the first bit is read
+
+	for (;;) {
+		if (rd->pos == rd->chunk_bits) {
+			size_t num_bits = 0;
+			const uint8_t* next = (rd->fetch != NULL) ? rd->fetch(rd->ctx, &num_bits) : NULL;
+			if (next == NULL) {
+				break;  // end of message
+			}
+			rd->chunk = next;
+			rd->chunk_bits = num_bits;
+			rd->pos = 0;
+			continue;
+		}
+
+		uint8_t byte = rd->chunk[rd->pos >> 3];
+		unsigned bit = (byte >> (7U - (rd->pos & 7U))) & 1U;
+
+		if (level == 2U) {
+			level = bit;
+		} else if (bit != level) {
+			break;  // run is over
+		}
+
+		/* Fast path: a whole byte of the same level (long dashes and gaps). */
+		if ((rd->pos & 7U) == 0U && rd->pos + 8U <= rd->chunk_bits && byte == (level ? 0xFFU : 0x00U)) {
+			run += 8U;
+			rd->pos += 8U;
+		} else {
+			run++;
+			rd->pos++;
+		}
+	}
+
+	*on = (level == 1U);
+	return run;
+}
+
+#endif /* MORSE_BITS_H */
@@ -0,0 +1,103 @@
+#ifndef MORSE_CLOCK_H
+#define MORSE_CLOCK_H
+
+#include <zephyr/kernel.h>  // k_sleep(), K_TIMEOUT_ABS_TICKS, k_uptime_ticks()
+
+/*
+ * Drift-free Morse timing.
+ *
+ * k_msleep(150) means "150 ms from NOW", and NOW is always a little late
+ * (GPIO call, printk, other threads). Those little bits add up every edge, so
+ * after an hour one LED is noticeably out of step with the others.
+ *
+ * A morse_clock remembers when the transmission started and how many us of
+ * Morse have been played since. Each edge is due at
+ *
+ *   deadline = start + elapsed_us      (converted to ticks once, not added up)
+ *
+ * and we sleep until that absolute time. Being late on one edge no longer
+ * pushes every later edge back. The lateness of every edge is measured, so
+ * you can check it stays small (max_late_ticks).
+ *
+ * With absolute = false it sleeps the old way (k_usleep) but still measures
+ * lateness against the ideal schedule, which shows the drift growing.
+ *
+ * High-speed mode (precise = true): a kernel timeout can only end on a tick,
+ * so a unit of a few hundred us would be rounded to whole ticks and dots and
+ * dashes would lose their 1:3 ratio. In this mode the clock sleeps until the
+ * tick just before the deadline and then spins on the hardware cycle counter
+ * for the rest. Every edge lands on its exact cycle, at the cost of up to
+ * about one tick of busy CPU per edge, so only use it for fast units.
+ */
+
+struct morse_clock {
+	bool absolute;          // true: sleep to absolute deadlines, false: relative k_usleep()
+	bool precise;           // high-speed mode: finish each wait on the cycle counter
+	int64_t start;          // tick when the transmission started
+	uint32_t start_cyc;     // k_cycle_get_32() at the start (for precise mode)
+	uint64_t elapsed_us;    // Morse time played so far
+	int64_t deadline;       // tick when the current edge should have happened
+	int64_t last_late;      // lateness of the most recent edge (ticks, >= 0)
+	int64_t max_late;       // worst lateness seen so far (ticks)
+	uint32_t edges;         // how many edges so far
+};
+
+void morse_clock_start(struct morse_clock* clk, bool absolute) {
+	// Start counting from now. The first edge is due immediately.
+	clk->absolute = absolute;
+	clk->precise = false;
+	clk->start = k_uptime_ticks();
+	clk->start_cyc = k_cycle_get_32();
+	clk->elapsed_us = 0;
+	clk->deadline = clk->start;
+	clk->last_late = 0;
+	clk->max_late = 0;
+	clk->edges = 0;
+}
+
+/* Call right before setting the LED: records how late this edge is. */
+static inline void morse_clock_edge(struct morse_clock* clk)
+{
+	int64_t late = k_uptime_ticks() - clk->deadline;
+
+	if (late < 0) {
+		late = 0;  // woke up early (tick rounding), count it as on time
+	}
+	clk->last_late = late;
+	if (late > clk->max_late) {
+		clk->max_late = late;
+	}
+	clk->edges++;
+}
+
+/* Call right after setting the LED: wait until the next edge is due, us after this one. */
+static inline void morse_clock_wait_us(struct morse_clock* clk, uint32_t us)
+{
+	clk->elapsed_us += us;
+	clk->deadline = clk->start + (int64_t)k_us_to_ticks_ceil64(clk->elapsed_us);
+
+	if (!clk->absolute) {
+		k_usleep((int32_t)us);
+		return;
+	}
+	if (!clk->precise) {
+		k_sleep(K_TIMEOUT_ABS_TICKS(clk->deadline));
+		return;
+	}
+
+	/* High-speed: sleep to the tick before the deadline, spin the rest. */
+	uint32_t deadline_cyc = clk->start_cyc + (uint32_t)k_us_to_cyc_ceil64(clk->elapsed_us);
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(clk->start + (int64_t)k_us_to_ticks_floor64(clk->elapsed_us) - 1));
+	while ((int32_t)(deadline_cyc - k_cycle_get_32()) > 0) {
+		/* spin */
+	}
+}
+
+/* Same as morse_clock_wait_us(), in ms. */
+static inline void morse_clock_wait(struct morse_clock* clk, uint32_t ms)
+{
+	morse_clock_wait_us(clk, ms * 1000U);
+}
+
+#endif /* MORSE_CLOCK_H */
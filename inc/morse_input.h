@@ -0,0 +1,269 @@
+#ifndef MORSE_INPUT_H
+#define MORSE_INPUT_H
+
+#include <stdlib.h>               // strtoul()
+#include <string.h>               // strlen(), strcpy()
+#include <zephyr/kernel.h>        // k_sem
+#include <zephyr/devicetree.h>    // DT_CHOSEN()
+#include <zephyr/drivers/uart.h>  // interrupt driven UART
+#include <zephyr/shell/shell.h>   // shell_print(), shell_error()
+#include <morse_shell.h>          // the "morse" command
+#include <morse_queue.h>          // struct morse_queue, morse_queue_push()
+#include <morse_speed.h>          // MORSE_SPEED_PACK(), morse_speed_set()
+
+/*
+ * Runtime message input: new text for any LED, without reflashing.
+ *
+ * 1) Shell:
+ *      uart:~$ morse set 0 sos
+ *      uart:~$ morse set 0 "hello world" 1 cq 2 de 3 k
+ *    Every pair on one command line is one batch (applied together).
+ *
+ *      uart:~$ morse speed 0 25          (25 WPM)
+ *      uart:~$ morse speed 0 25 10       (letters at 25 WPM, 10 WPM overall)
+ *    Only if the program gave us its speed words (morse_input_speeds()).
+ *
+ * 2) UART binary protocol, on the UART chosen as "geoffcha,morse-uart":
+ *
+ *      0x7E  count  { led  len  text[len] } x count  sum
+ *
+ *    sum = 8-bit sum of every byte after 0x7E (count ... last text byte).
+ *    The board answers 0x06 (ACK) when the batch is queued, 0x15 (NAK) if the
+ *    frame was bad or the queue was full. A frame is one batch.
+ *    A frame that stops for more than MORSE_UART_IDLE_BYTES byte times is
+ *    dropped without an answer, so a lost byte costs that frame only: the
+ *    next 0x7E starts a new frame instead of being taken for text.
+ *
+ * Both only push into the lock-free queue and wake the consumer; they never
+ * touch the LEDs or wait for them.
+ */
+
+#define MORSE_INPUT_MAX_BATCH 8   // updates per command / frame
+
+#define MORSE_UART_START 0x7E
+#define MORSE_UART_ACK   0x06
+#define MORSE_UART_NAK   0x15
+
+static struct morse_queue* input_queue;  // where updates go
+static struct k_sem* input_wake;         // given after every batch
+static size_t input_num_chans;           // valid LED numbers: 0 .. input_num_chans-1
+static atomic_t* input_speeds;           // packed speed per LED (NULL = no "morse speed")
+
+/* --- Shell: morse set <led> <text> [<led> <text> ...] --- */
+
+static int cmd_morse_set(const struct shell* sh, size_t argc, char** argv)
+{
+	struct morse_update upds[MORSE_INPUT_MAX_BATCH];
+	size_t count = 0;
+
+	if ((argc - 1) % 2 != 0) {
+		shell_error(sh, "expected pairs of <led> <text>");
+		return -EINVAL;
+	}
+
+	for (size_t i = 1; i + 1 < argc; i += 2) {
+		char* end;
+		unsigned long chan = strtoul(argv[i], &end, 10);
+
+		if (*end != '\0' || chan >= input_num_chans) {
+			shell_error(sh, "bad LED number: %s", argv[i]);
+			return -EINVAL;
+		}
+		if (strlen(argv[i + 1]) > MORSE_MSG_MAX) {
+			shell_error(sh, "text too long (max %d chars)", MORSE_MSG_MAX);
+			return -EINVAL;
+		}
+
+		upds[count].chan = (uint8_t)chan;
+		strcpy(upds[count].text, argv[i + 1]);
+		count++;
+	}
+
+	int ret = morse_queue_push(input_queue, upds, count);
+	if (ret < 0) {
+		shell_error(sh, "queue full, try again");
+		return ret;
+	}
+	k_sem_give(input_wake);
+
+	shell_print(sh, "queued %u update(s)", (unsigned)count);
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), set, NULL, "Send new text: set <led> <text> [<led> <text> ...]",
+                 cmd_morse_set, 3, 2 * (MORSE_INPUT_MAX_BATCH - 1));
+
+/* --- Shell: morse speed <led> <wpm> [<farnsworth wpm>] --- */
+
+static int cmd_morse_speed(const struct shell* sh, size_t argc, char** argv)
+{
+	struct morse_speed sp;
+	char* end;
+	unsigned long chan = strtoul(argv[1], &end, 10);
+	unsigned long wpm = strtoul(argv[2], NULL, 10);
+	unsigned long fwpm = (argc > 3) ? strtoul(argv[3], NULL, 10) : 0;
+
+	if (input_speeds == NULL) {
+		shell_error(sh, "this program has fixed speeds");
+		return -ENOTSUP;
+	}
+	if (*end != '\0' || chan >= input_num_chans) {
+		shell_error(sh, "bad LED number: %s", argv[1]);
+		return -EINVAL;
+	}
+	if (wpm > 0xFFFFU || fwpm > 0xFFFFU || morse_speed_set(&sp, wpm, fwpm) < 0) {
+		shell_error(sh, "bad speed (1..65535 WPM)");
+		return -EINVAL;
+	}
+
+	atomic_set(&input_speeds[chan], (atomic_val_t)MORSE_SPEED_PACK(wpm, fwpm));
+	shell_print(sh, "LED%lu: T=%u us, letter gap %u us, word gap %u us (from the next word)",
+	            chan, sp.unit_us, sp.letter_gap_us, sp.word_gap_us);
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), speed, NULL, "Set speed: speed <led> <wpm> [<farnsworth wpm>]",
+                 cmd_morse_speed, 3, 1);
+
+void morse_input_speeds(atomic_t* speeds) {
+	// Enable "morse speed": it stores MORSE_SPEED_PACK(wpm, fwpm) in speeds[led].
+	// The program reads them whenever it likes (e.g. at every word gap).
+	input_speeds = speeds;
+}
+
+/* --- UART binary protocol --- */
+
+#if DT_HAS_CHOSEN(geoffcha_morse_uart)
+
+#define MORSE_UART_NODE DT_CHOSEN(geoffcha_morse_uart)
+
+#define MORSE_UART_IDLE_BYTES 8   // silence inside a frame that drops it, in byte times
+#define MORSE_UART_BAUD DT_PROP_OR(MORSE_UART_NODE, current_speed, 115200)
+#define MORSE_UART_IDLE_US (MORSE_UART_IDLE_BYTES * 10U * 1000000U / MORSE_UART_BAUD)  // 10 bits/byte
+
+enum morse_uart_state { WAIT_START, GET_COUNT, GET_LED, GET_LEN, GET_TEXT, GET_SUM };
+
+/* Frame being received (only touched from the UART interrupt). */
+static struct {
+	enum morse_uart_state state;
+	uint32_t last_cyc;   // when the previous byte came in
+	uint8_t count;       // updates in this frame
+	uint8_t idx;         // update being received
+	uint8_t len;         // text length of that update
+	uint8_t pos;         // text bytes received so far
+	uint8_t sum;         // running checksum
+	struct morse_update upds[MORSE_INPUT_MAX_BATCH];
+} rx_frame;
+
+/* Feed one received byte to the frame parser; answers ACK/NAK at the end of a frame. */
+static void morse_uart_feed(const struct device* dev, uint8_t byte)
+{
+	uint32_t now = k_cycle_get_32();
+
+	/* The rest of a stalled frame is not coming: start over with this byte. */
+	if (rx_frame.state != WAIT_START && now - rx_frame.last_cyc > k_us_to_cyc_ceil32(MORSE_UART_IDLE_US)) {
+		rx_frame.state = WAIT_START;
+	}
+	rx_frame.last_cyc = now;
+
+	if (rx_frame.state != WAIT_START && rx_frame.state != GET_SUM) {
+		rx_frame.sum += byte;
+	}
+
+	switch (rx_frame.state) {
+	case WAIT_START:
+		if (byte == MORSE_UART_START) {
+			rx_frame.sum = 0;
+			rx_frame.idx = 0;
+			rx_frame.state = GET_COUNT;
+		}
+		return;
+
+	case GET_COUNT:
+		rx_frame.count = byte;
+		rx_frame.state = GET_LED;
+		if (byte == 0 || byte > MORSE_INPUT_MAX_BATCH) {
+			break;  // bad frame
+		}
+		return;
+
+	case GET_LED:
+		rx_frame.upds[rx_frame.idx].chan = byte;
+		rx_frame.state = GET_LEN;
+		if (byte >= input_num_chans) {
+			break;
+		}
+		return;
+
+	case GET_LEN:
+		rx_frame.len = byte;
+		rx_frame.pos = 0;
+		rx_frame.state = GET_TEXT;
+		if (byte == 0 || byte > MORSE_MSG_MAX) {
+			break;
+		}
+		return;
+
+	case GET_TEXT:
+		rx_frame.upds[rx_frame.idx].text[rx_frame.pos++] = (char)byte;
+		if (rx_frame.pos == rx_frame.len) {
+			rx_frame.upds[rx_frame.idx].text[rx_frame.pos] = '\0';
+			rx_frame.idx++;
+			rx_frame.state = (rx_frame.idx == rx_frame.count) ? GET_SUM : GET_LED;
+		}
+		return;
+
+	case GET_SUM:
+		rx_frame.state = WAIT_START;
+		if (byte == rx_frame.sum &&
+		    morse_queue_push(input_queue, rx_frame.upds, rx_frame.count) == 0) {
+			k_sem_give(input_wake);
+			uart_poll_out(dev, MORSE_UART_ACK);
+			return;
+		}
+		break;
+	}
+
+	/* Anything that falls out of the switch is a bad frame: drop it. */
+	rx_frame.state = WAIT_START;
+	uart_poll_out(dev, MORSE_UART_NAK);
+}
+
+static void morse_uart_isr(const struct device* dev, void* user_data)
+{
+	ARG_UNUSED(user_data);
+	uint8_t byte;
+
+	if (!uart_irq_update(dev)) {
+		return;
+	}
+	while (uart_irq_rx_ready(dev) && uart_fifo_read(dev, &byte, 1) == 1) {
+		morse_uart_feed(dev, byte);
+	}
+}
+
+#endif /* DT_HAS_CHOSEN(geoffcha_morse_uart) */
+
+int morse_input_init(struct morse_queue* q, struct k_sem* wake, size_t num_chans) {
+	// Connect the shell command and the UART protocol to queue q.
+	// wake is given after every batch so the consumer can sleep until then.
+	// Returns: 0 on success, -ENODEV if the Morse UART is not ready.
+
+	input_queue = q;
+	input_wake = wake;
+	input_num_chans = num_chans;
+
+#if DT_HAS_CHOSEN(geoffcha_morse_uart)
+	const struct device* uart = DEVICE_DT_GET(MORSE_UART_NODE);
+
+	if (!device_is_ready(uart)) {
+		return -ENODEV;
+	}
+	uart_irq_callback_user_data_set(uart, morse_uart_isr, NULL);
+	uart_irq_rx_enable(uart);
+#endif
+
+	return 0;
+}
+
+#endif /* MORSE_INPUT_H */
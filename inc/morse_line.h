@@ -0,0 +1,238 @@
+#ifndef MORSE_LINE_H
+#define MORSE_LINE_H
+
+#include <stdint.h>               // uint8_t
+#include <stdbool.h>              // bool
+#include <string.h>               // memset()
+#include <errno.h>                // EINVAL, ENOMEM
+#include <zephyr/drivers/gpio.h>  // gpio_pin_get_dt()
+#include <zephyr/sys/crc.h>       // crc16_itu_t()
+#include <morse_bits.h>           // morse_bits_put(): same 1-bit-per-unit format
+
+/*
+ * Line coding: binary frames on an LED instead of Morse.
+ *
+ * Morse spends most of its time dark (3T between letters, 7T between words)
+ * and an 'e' costs as much gap as a '0'. For data, a channel can send framed
+ * bytes instead, one on-off keyed bit per unit T (NRZ) or per 2T (Manchester):
+ *
+ *   NRZ:         1 = on for T,           0 = off for T
+ *   Manchester:  1 = off T then on T,    0 = on T then off T  (IEEE 802.3)
+ *
+ * NRZ is twice as fast; Manchester has an edge in the middle of every bit
+ * (a receiver can recover the clock from it) and is on exactly half the time
+ * whatever the data, so the LED never looks dimmer or brighter.
+ *
+ * Frame, sent MSB first:
+ *
+ *   preamble  0x55 x MORSE_LINE_PREAMBLE_BYTES   1010... to settle on
+ *   sync      0xD3                               "frame starts here"
+ *   length    1 byte, 0..MORSE_LINE_MAX_PAYLOAD
+ *   payload   length bytes
+ *   crc       CRC-16/CCITT (poly 0x1021, init 0xFFFF) of length + payload, high byte first
+ *   idle      MORSE_LINE_GAP_UNITS units off
+ *
+ * The encoder writes a morse_bits.h bitstream, so a frame plays on any channel
+ * that plays bitstreams (morse_sched.h, morse_pwm.h, ...) and loops like a
+ * Morse message does: each channel picks Morse or a line code on its own.
+ *
+ * The receiver samples its pin in the middle of every unit on the sender's
+ * clock (same T, as in morse_stripe.h), hunts for the last preamble byte
+ * followed by the sync byte, then collects the frame and checks the CRC.
+ */
+
+#define MORSE_LINE_PREAMBLE_BYTES 2
+#define MORSE_LINE_SYNC           0xD3
+#define MORSE_LINE_MAX_PAYLOAD    64
+#define MORSE_LINE_GAP_UNITS      16U  // line off between frames
+
+enum morse_line_code {
+	MORSE_LINE_NRZ,
+	MORSE_LINE_MANCHESTER,
+};
+
+/* Units per bit of a line code. */
+#define MORSE_LINE_UNITS_PER_BIT(code) (((code) == MORSE_LINE_MANCHESTER) ? 2U : 1U)
+
+/* Units of one frame of len payload bytes, idle included. */
+#define MORSE_LINE_FRAME_UNITS(code, len) \
+	((MORSE_LINE_PREAMBLE_BYTES + 4U + (len)) * 8U * MORSE_LINE_UNITS_PER_BIT(code) + MORSE_LINE_GAP_UNITS)
+
+/* Append one byte, MSB first, in the given line code. */
+static int morse_line_put_byte(enum morse_line_code code, uint8_t byte, uint8_t* buf, size_t buf_len, size_t* nbits)
+{
+	int ret = 0;
+
+	for (int b = 7; ret == 0 && b >= 0; b--) {
+		bool one = ((byte >> b) & 1U) != 0U;
+
+		if (code == MORSE_LINE_MANCHESTER) {
+			ret = morse_bits_put(buf, buf_len, nbits, !one, 1);
+			if (ret == 0) {
+				ret = morse_bits_put(buf, buf_len, nbits, one, 1);
+			}
+		} else {
+			ret = morse_bits_put(buf, buf_len, nbits, one, 1);
+		}
+	}
+	return ret;
+}
+
+int morse_line_encode(enum morse_line_code code, const uint8_t* data, size_t len, uint8_t* buf, size_t buf_len) {
+	// Encodes len bytes of data as one frame (see above) into a bitstream.
+	// Returns: number of bits (units) written, -EINVAL if len is too big,
+	//          -ENOMEM if buf is too small.
+
+	size_t nbits = 0;
+	int ret = 0;
+
+	if (len > MORSE_LINE_MAX_PAYLOAD) {
+		return -EINVAL;
+	}
+	memset(buf, 0, buf_len);
+
+	uint8_t len_byte = (uint8_t)len;
+	uint16_t crc = crc16_itu_t(0xFFFF, &len_byte, 1);
+	crc = crc16_itu_t(crc, data, len);
+
+	for (int i = 0; ret == 0 && i < MORSE_LINE_PREAMBLE_BYTES; i++) {
+		ret = morse_line_put_byte(code, 0x55, buf, buf_len, &nbits);
+	}
+	if (ret == 0) {
+		ret = morse_line_put_byte(code, MORSE_LINE_SYNC, buf, buf_len, &nbits);
+	}
+	if (ret == 0) {
+		ret = morse_line_put_byte(code, len_byte, buf, buf_len, &nbits);
+	}
+	for (size_t i = 0; ret == 0 && i < len; i++) {
+		ret = morse_line_put_byte(code, data[i], buf, buf_len, &nbits);
+	}
+	if (ret == 0) {
+		ret = morse_line_put_byte(code, (uint8_t)(crc >> 8), buf, buf_len, &nbits);
+	}
+	if (ret == 0) {
+		ret = morse_line_put_byte(code, (uint8_t)crc, buf, buf_len, &nbits);
+	}
+	if (ret == 0) {
+		ret = morse_bits_put(buf, buf_len, &nbits, false, MORSE_LINE_GAP_UNITS);
+	}
+	return (ret < 0) ? ret : (int)nbits;
+}
+
+/* --- Receiver --- */
+
+struct morse_line_rx;
+typedef void (*morse_line_frame_cb)(struct morse_line_rx* rx, const uint8_t* data, size_t len);
+
+struct morse_line_rx {
+	const struct gpio_dt_spec* in;    // input pin
+	enum morse_line_code code;
+	morse_line_frame_cb on_frame;     // gets every frame with a good CRC
+	uint32_t sync_word;               // last preamble byte + sync, as line samples
+	uint32_t sync_mask;
+	uint32_t shift;                   // last 32 samples, newest in bit 0
+	bool in_frame;                    // sync seen, collecting bytes
+	uint8_t half;                     // Manchester: samples of the current bit so far
+	uint8_t byte;                     // bits of the current byte so far
+	uint8_t num_bits;
+	uint8_t frame[MORSE_LINE_MAX_PAYLOAD + 3];  // length, payload, crc
+	size_t len;                       // bytes in frame[]
+	uint32_t frames;                  // good frames
+	uint32_t crc_errors;              // frames thrown away for a bad CRC
+	uint32_t code_errors;             // Manchester bits with no edge in the middle (frame dropped)
+};
+
+/* A whole frame is in: check its CRC and hand the payload on. */
+static void morse_line_rx_frame(struct morse_line_rx* rx)
+{
+	size_t len = rx->frame[0];
+	uint16_t crc = crc16_itu_t(0xFFFF, rx->frame, len + 1U);
+
+	if (crc == (uint16_t)((rx->frame[len + 1U] << 8) | rx->frame[len + 2U])) {
+		rx->frames++;
+		rx->on_frame(rx, &rx->frame[1], len);
+	} else {
+		rx->crc_errors++;
+	}
+	rx->in_frame = false;
+}
+
+int morse_line_rx_init(struct morse_line_rx* rx, const struct gpio_dt_spec* in, enum morse_line_code code,
+                       morse_line_frame_cb on_frame) {
+	// Receive frames in line code code on pin in (configured here as an input).
+	// Returns: 0 on success, -ENODEV if the GPIO is not ready, or a GPIO error code.
+
+	if (!gpio_is_ready_dt(in)) {
+		return -ENODEV;
+	}
+	int ret = gpio_pin_configure_dt(in, GPIO_INPUT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memset(rx, 0, sizeof(*rx));
+	rx->in = in;
+	rx->code = code;
+	rx->on_frame = on_frame;
+
+	/* What 0x55, 0xD3 look like on the line: 16 samples in NRZ, 32 in Manchester. */
+	uint16_t sync = 0x5500U | MORSE_LINE_SYNC;
+	for (int b = 15; b >= 0; b--) {
+		uint32_t one = (sync >> b) & 1U;
+		if (code == MORSE_LINE_MANCHESTER) {
+			rx->sync_word = (rx->sync_word << 2) | (one ? 0x1U : 0x2U);
+		} else {
+			rx->sync_word = (rx->sync_word << 1) | one;
+		}
+	}
+	rx->sync_mask = (code == MORSE_LINE_MANCHESTER) ? 0xFFFFFFFFU : 0xFFFFU;
+	return 0;
+}
+
+void morse_line_rx_sample(struct morse_line_rx* rx) {
+	// Call once per unit T, in the middle of the unit (e.g. from a k_timer).
+	// Good frames go to on_frame from here.
+
+	uint32_t level = (gpio_pin_get_dt(rx->in) > 0) ? 1U : 0U;
+	uint32_t bit = level;
+
+	rx->shift = (rx->shift << 1) | level;
+
+	if (!rx->in_frame) {
+		if ((rx->shift & rx->sync_mask) == rx->sync_word) {
+			rx->in_frame = true;
+			rx->half = 0;
+			rx->num_bits = 0;
+			rx->len = 0;
+		}
+		return;
+	}
+
+	if (rx->code == MORSE_LINE_MANCHESTER) {
+		if (++rx->half < 2U) {
+			return;  // first half of the bit
+		}
+		rx->half = 0;
+		if ((rx->shift & 3U) == 0U || (rx->shift & 3U) == 3U) {
+			rx->code_errors++;  // no edge in the middle: not Manchester any more
+			rx->in_frame = false;
+			return;
+		}
+		bit = ((rx->shift & 3U) == 1U) ? 1U : 0U;  // off-on = 1
+	}
+
+	rx->byte = (uint8_t)((rx->byte << 1) | bit);
+	if (++rx->num_bits < 8U) {
+		return;
+	}
+	rx->num_bits = 0;
+	rx->frame[rx->len++] = rx->byte;
+
+	if (rx->frame[0] > MORSE_LINE_MAX_PAYLOAD) {
+		rx->in_frame = false;  // cannot be a length of ours: hunt again
+	} else if (rx->len == rx->frame[0] + 3U) {
+		morse_line_rx_frame(rx);
+	}
+}
+
+#endif /* MORSE_LINE_H */
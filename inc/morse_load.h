@@ -0,0 +1,132 @@
+#ifndef MORSE_LOAD_H
+#define MORSE_LOAD_H
+
+#include <stdlib.h>               // strtoul()
+#include <zephyr/kernel.h>        // k_thread_create(), k_busy_wait()
+#include <zephyr/sys/atomic.h>    // atomic_get(), atomic_set()
+#include <zephyr/sys/util.h>      // MIN(), MAX(), IS_ENABLED()
+#include <zephyr/shell/shell.h>   // shell_print()
+#include <morse_shell.h>          // the "morse" command
+
+/*
+ * Synthetic CPU load, to see what other work does to LED timing.
+ *
+ * One thread burns the CPU (k_busy_wait) for busy_ms out of every period_ms.
+ * It runs at the SAME priority as the LED threads: a higher priority would
+ * simply win every time whatever the LEDs do, a lower one would never get in
+ * their way. At equal priority it comes down to how the scheduler breaks the tie:
+ *
+ *   fixed priority (default): whoever runs first keeps the CPU until it
+ *     sleeps, so an LED edge that falls inside a burst waits for the whole
+ *     burst (edges up to busy_ms late);
+ *   EDF (-DMORSE_EDF=ON, CONFIG_SCHED_DEADLINE): every thread tells the
+ *     kernel when its next deadline is. The LED threads use their next edge,
+ *     the load thread the end of its period, so a waking LED thread has the
+ *     earlier deadline and preempts the burst (edges stay on time).
+ *
+ *   uart:~$ morse load               show the current load
+ *   uart:~$ morse load 30            30 ms busy in every 100 ms
+ *   uart:~$ morse load 30 50         30 ms busy in every 50 ms
+ *   uart:~$ morse load 0             off
+ *
+ * The lateness report (or the benchmark, -DMORSE_BENCH=ON) shows the effect.
+ *
+ * No load costs nothing: the thread is only created by the first non-zero
+ * load, and while the load is 0 it waits on a semaphore instead of waking up
+ * every period.
+ */
+
+#define MORSE_LOAD_PERIOD_MS 100  // default period
+#define MORSE_LOAD_STACK_SIZE 512
+
+static atomic_t load_busy_ms;
+static atomic_t load_period_ms = ATOMIC_INIT(MORSE_LOAD_PERIOD_MS);
+static uint32_t load_bursts;  // bursts so far
+static int load_prio;
+static bool load_prio_set;  // morse_load_start() has run
+static atomic_t load_started;
+K_SEM_DEFINE(load_wake, 0, 1);  // load went from 0 to non-zero
+
+K_KERNEL_STACK_DEFINE(load_stack, MORSE_LOAD_STACK_SIZE);
+static struct k_thread load_thread;
+
+static void morse_load_entry(void* p1, void* p2, void* p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	int64_t next = k_uptime_get();
+
+	while (1) {
+		uint32_t busy = (uint32_t)atomic_get(&load_busy_ms);
+		uint32_t period = (uint32_t)atomic_get(&load_period_ms);
+
+		if (busy == 0U) {
+			/* Off: sleep until "morse load" turns it back on, then start a fresh period. */
+			k_sem_take(&load_wake, K_FOREVER);
+			next = k_uptime_get();
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_DEADLINE
+		/* Due by the end of this period: later than any LED edge that comes up meanwhile. */
+		k_thread_deadline_set(k_current_get(), (int)k_ms_to_cyc_ceil32(period));
+#endif
+		k_busy_wait(MIN(busy, period) * 1000U);
+		load_bursts++;
+		next += period;
+		k_sleep(K_TIMEOUT_ABS_MS(next));
+	}
+}
+
+void morse_load_set(uint32_t busy_ms, uint32_t period_ms) {
+	// Burn busy_ms of CPU in every period_ms (busy_ms = 0: no load).
+	// Takes effect at the next period; the first non-zero load creates the
+	// thread, once morse_load_start() has said at which priority.
+	atomic_set(&load_period_ms, (atomic_val_t)MAX(period_ms, 1U));
+	atomic_set(&load_busy_ms, (atomic_val_t)busy_ms);
+	if (busy_ms == 0U || !load_prio_set) {
+		return;
+	}
+	if (atomic_cas(&load_started, 0, 1)) {
+		k_thread_create(&load_thread, load_stack, K_KERNEL_STACK_SIZEOF(load_stack), morse_load_entry,
+		                NULL, NULL, NULL, load_prio, 0, K_NO_WAIT);
+		k_thread_name_set(&load_thread, "morse_load");
+	} else {
+		k_sem_give(&load_wake);
+	}
+}
+
+void morse_load_start(int prio, uint32_t busy_ms) {
+	// Set the load thread's priority (the LED threads' priority) and
+	// start with busy_ms in every MORSE_LOAD_PERIOD_MS. With busy_ms = 0 no
+	// thread exists until "morse load <busy>".
+	load_prio = prio;
+	load_prio_set = true;
+	morse_load_set(busy_ms, MORSE_LOAD_PERIOD_MS);
+}
+
+static int cmd_morse_load(const struct shell* sh, size_t argc, char** argv)
+{
+	if (argc > 1) {
+		uint32_t busy = (uint32_t)strtoul(argv[1], NULL, 10);
+		uint32_t period = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : MORSE_LOAD_PERIOD_MS;
+
+		if (period == 0U || busy > period) {
+			shell_error(sh, "need 0 <= busy <= period, period > 0");
+			return -EINVAL;
+		}
+		morse_load_set(busy, period);
+	}
+
+	shell_print(sh, "load: %u ms busy every %u ms, %u bursts, %s scheduling",
+	            (uint32_t)atomic_get(&load_busy_ms), (uint32_t)atomic_get(&load_period_ms), load_bursts,
+	            IS_ENABLED(CONFIG_SCHED_DEADLINE) ? "EDF" : "fixed priority");
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), load, NULL, "CPU load at LED priority: load [<busy ms> [<period ms>]]",
+                 cmd_morse_load, 1, 2);
+
+#endif /* MORSE_LOAD_H */
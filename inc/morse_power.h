@@ -0,0 +1,88 @@
+#ifndef MORSE_POWER_H
+#define MORSE_POWER_H
+
+#include <string.h>               // strcmp()
+#include <zephyr/kernel.h>        // k_thread_foreach(), k_thread_runtime_stats_get()
+#include <zephyr/shell/shell.h>   // shell_print()
+#include <morse_shell.h>          // the "morse" command
+
+/*
+ * How much the CPU sleeps: wakeups and time in idle, for the low-power mode
+ * (lowpower.conf, -DMORSE_LOWPOWER=ON).
+ *
+ * Both numbers come from the kernel's own bookkeeping of the idle thread:
+ *   - its execution time IS the time the CPU spent idle;
+ *   - every stretch it runs ("window") ends with something waking the CPU,
+ *     so the number of windows is the number of wakeups.
+ * Nothing is added to the hot path.
+ *
+ *   uart:~$ morse power          wakeups and idle time since boot (or reset)
+ *   uart:~$ morse power reset    start a new measurement window
+ *
+ * Needs CONFIG_SCHED_THREAD_USAGE_ANALYSIS and CONFIG_THREAD_MONITOR.
+ */
+
+struct morse_power {
+	uint64_t wakeups;   // times the CPU left idle
+	uint64_t idle_us;   // time spent idle
+	uint64_t up_us;     // time since boot
+};
+
+static struct morse_power power_base;  // "morse power reset" snapshot
+
+/* k_thread_foreach() callback: add up every idle thread (one per CPU). */
+static void morse_power_add_idle(const struct k_thread* cthread, void* user_data)
+{
+	struct k_thread* thread = (struct k_thread*)cthread;
+	struct morse_power* p = user_data;
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_priority_get(thread) != K_IDLE_PRIO) {
+		return;
+	}
+	if (k_thread_runtime_stats_get(thread, &stats) == 0) {
+		p->idle_us += k_cyc_to_us_floor64(stats.execution_cycles);
+		p->wakeups += stats.num_windows;
+	}
+}
+
+void morse_power_get(struct morse_power* p) {
+	// Wakeups and idle time since boot.
+	p->wakeups = 0;
+	p->idle_us = 0;
+	p->up_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	k_thread_foreach(morse_power_add_idle, p);
+}
+
+void morse_power_since_reset(struct morse_power* p) {
+	// Same, counted from the last "morse power reset" (or boot).
+	morse_power_get(p);
+	p->wakeups -= power_base.wakeups;
+	p->idle_us -= power_base.idle_us;
+	p->up_us -= power_base.up_us;
+}
+
+static int cmd_morse_power(const struct shell* sh, size_t argc, char** argv)
+{
+	struct morse_power p;
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		morse_power_get(&power_base);
+		shell_print(sh, "power counters reset");
+		return 0;
+	}
+
+	morse_power_since_reset(&p);
+	if (p.up_us == 0U) {
+		return 0;
+	}
+	shell_print(sh, "up %u ms, idle %u ms (%u.%u%%), %u wakeups (%u per s)",
+	            (uint32_t)(p.up_us / 1000U), (uint32_t)(p.idle_us / 1000U),
+	            (uint32_t)(p.idle_us * 100U / p.up_us), (uint32_t)(p.idle_us * 1000U / p.up_us % 10U),
+	            (uint32_t)p.wakeups, (uint32_t)(p.wakeups * 1000000U / p.up_us));
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), power, NULL, "Wakeups and idle time: power [reset]", cmd_morse_power, 1, 1);
+
+#endif /* MORSE_POWER_H */
@@ -0,0 +1,245 @@
+#ifndef MORSE_PWM_H
+#define MORSE_PWM_H
+
+#include <stdlib.h>               // strtoul()
+#include <string.h>               // memset()
+#include <zephyr/kernel.h>        // k_timer
+#include <zephyr/drivers/gpio.h>  // gpio_port_set_masked()
+#include <zephyr/shell/shell.h>   // shell_print()
+#include <morse_shell.h>          // the "morse" command
+#include <gpio_batch.h>           // gpio_batch_add(): one slot per GPIO port
+#include <morse_bits.h>           // bit-packed messages streamed run by run
+
+/*
+ * Software PWM for every Morse LED, from ONE timer.
+ *
+ * Each LED gets a brightness and soft edges: a mark does not switch on, it
+ * fades in along a raised-cosine curve (and fades out the same way after it),
+ * like a well-shaped CW transmitter instead of a hard key click.
+ *
+ * Time is cut into PWM frames of MORSE_PWM_STEPS steps. The timer fires once
+ * per step and does ONE masked write per GPIO port:
+ *
+ *   step:    0 1 2 3 4 5 6 7 8 9 ...15 | 0 1 2 ...
+ *   LED a:   # # # # # # # # . . ... . |            level 8 of 16
+ *   LED b:   # # # . . . . . . . ... . |            level 3 of 16
+ *
+ * At the start of every frame the engine moves each channel's Morse key and
+ * ramp along, works out its level (0..MORSE_PWM_STEPS) and builds the port
+ * values for all 16 steps of the frame: masks[step][port] has the bit of
+ * every LED whose level is above that step. The other 15 steps only copy a
+ * precomputed word to each port, and skip the write if it did not change.
+ * So 64 LEDs on two ports cost two GPIO writes per step, not 64.
+ *
+ * Morse timing is counted in whole frames (T = 150 ms with 1.6 ms frames is
+ * 93 frames = 148.8 ms); dots and dashes keep their exact 1:3 ratio.
+ *
+ * Like morse_sched.h, everything runs in the timer interrupt, so the LEDs
+ * must be on a GPIO controller that can be written from an ISR.
+ *
+ *   uart:~$ morse pwm                    every channel's brightness and ramp
+ *   uart:~$ morse pwm 2 25 6             channel 2 at 25 %, 6 ms fades
+ */
+
+#define MORSE_PWM_STEPS 16        // brightness levels (steps per frame)
+#define MORSE_PWM_MAX_CHANS 64
+
+/* Raised cosine (1 - cos(pi * i / 16)) / 2, scaled to 256: the fade-in curve, read backwards to fade out. */
+static const uint16_t morse_pwm_cos[17] = {
+	0, 2, 10, 22, 37, 57, 79, 103, 128, 153, 177, 199, 219, 234, 246, 254, 256
+};
+
+struct morse_pwm_chan {
+	const struct gpio_dt_spec* led;  // which LED
+	struct morse_bits_reader* bits;  // what it sends
+	uint32_t unit_ms;                // this channel's T in ms (0 = the engine's T)
+	uint8_t brightness;              // level of a mark, 0..MORSE_PWM_STEPS (may change any time)
+	uint8_t ramp_frames;             // fade in/out time in frames (0 = hard on/off, may change any time)
+
+	/* Engine state (set by morse_pwm_start()). */
+	uint8_t port_slot;               // this LED's port in morse_pwm.batch
+	bool key;                        // Morse level right now
+	uint8_t ramp_pos;                // 0 = dark .. ramp_frames = fully faded in
+	uint32_t unit_frames;            // T in frames
+	uint32_t frames_left;            // until the next Morse edge
+};
+
+struct morse_pwm {
+	struct k_timer timer;                   // one tick per PWM step
+	struct morse_pwm_chan* chans;           // channel array (owned by the caller)
+	size_t num_chans;
+	uint32_t frame_us;                      // length of one frame
+	struct gpio_batch batch;                // list of the ports we drive (slots)
+	gpio_port_pins_t pins[GPIO_BATCH_MAX_PORTS];                      // our pins, per port
+	gpio_port_value_t masks[MORSE_PWM_STEPS][GPIO_BATCH_MAX_PORTS];   // this frame, per step and port
+	gpio_port_value_t written[GPIO_BATCH_MAX_PORTS];                  // last value written, per port
+	uint8_t step;                           // next step to play
+	uint32_t frames;                        // frames played so far
+	uint32_t writes;                        // GPIO port writes so far
+};
+
+static struct morse_pwm* shell_pwm;  // the engine "morse pwm" works on
+
+/* Level of a channel in this frame: brightness times the ramp curve. */
+static inline uint8_t morse_pwm_level(const struct morse_pwm_chan* c)
+{
+	if (c->ramp_frames == 0U) {
+		return c->key ? c->brightness : 0U;
+	}
+	uint32_t gain = morse_pwm_cos[(uint32_t)c->ramp_pos * 16U / c->ramp_frames];
+	return (uint8_t)(((uint32_t)c->brightness * gain + 128U) >> 8);
+}
+
+/* Start of a frame: move every channel's key and ramp on, then lay out the frame's port values. */
+static void morse_pwm_frame(struct morse_pwm* s)
+{
+	memset(s->masks, 0, sizeof(s->masks));
+
+	for (size_t idx = 0; idx < s->num_chans; idx++) {
+		struct morse_pwm_chan* c = &s->chans[idx];
+
+		if (--c->frames_left == 0U) {
+			bool on;
+			uint32_t run = morse_bits_next_run(c->bits, &on);
+
+			if (run == 0U) {
+				morse_bits_rewind(c->bits);  // message over, start again
+				run = morse_bits_next_run(c->bits, &on);
+			}
+			c->key = on;
+			c->frames_left = run * c->unit_frames;
+		}
+
+		/* Fade towards the key, one frame at a time. */
+		uint8_t ramp = c->ramp_frames;
+		if (c->ramp_pos > ramp) {
+			c->ramp_pos = ramp;  // ramp was shortened meanwhile
+		}
+		if (c->key && c->ramp_pos < ramp) {
+			c->ramp_pos++;
+		} else if (!c->key && c->ramp_pos > 0U) {
+			c->ramp_pos--;
+		}
+
+		gpio_port_value_t bit = BIT(c->led->pin);
+		for (uint8_t step = morse_pwm_level(c); step > 0U; step--) {
+			s->masks[step - 1U][c->port_slot] |= bit;
+		}
+	}
+	s->frames++;
+}
+
+/* k_timer callback: one PWM step, one write per port that changes. */
+static void morse_pwm_tick(struct k_timer* timer)
+{
+	struct morse_pwm* s = CONTAINER_OF(timer, struct morse_pwm, timer);
+
+	if (s->step == 0U) {
+		morse_pwm_frame(s);
+	}
+	for (size_t p = 0; p < s->batch.num_ports; p++) {
+		gpio_port_value_t value = s->masks[s->step][p];
+
+		if (value != s->written[p]) {
+			gpio_port_set_masked(s->batch.ports[p].port, s->pins[p], value);
+			s->written[p] = value;
+			s->writes++;
+		}
+	}
+	s->step = (s->step + 1U) % MORSE_PWM_STEPS;
+}
+
+int morse_pwm_start(struct morse_pwm* s, struct morse_pwm_chan* chans, size_t num_chans,
+                    uint32_t t_ms, uint32_t step_us) {
+	// Start playing every channel from the beginning of its message, with a PWM
+	// step of step_us (rounded up to whole kernel ticks; a frame is 16 steps).
+	// t_ms is the Morse unit T of every channel that does not set its own.
+	// The LEDs must already be set up as outputs and off.
+	// Returns: 0, -EINVAL if there are no/too many channels,
+	//          -ENOMEM if the LEDs are spread over too many GPIO ports.
+
+	if (num_chans == 0 || num_chans > MORSE_PWM_MAX_CHANS) {
+		return -EINVAL;
+	}
+
+	k_ticks_t step_ticks = MAX(k_us_to_ticks_ceil32(step_us), 1U);
+
+	s->chans = chans;
+	s->num_chans = num_chans;
+	s->frame_us = k_ticks_to_us_near32((uint32_t)step_ticks) * MORSE_PWM_STEPS;
+	s->batch.num_ports = 0;
+	s->step = 0;
+	s->frames = 0;
+	s->writes = 0;
+	memset(s->pins, 0, sizeof(s->pins));
+	memset(s->written, 0, sizeof(s->written));
+
+	for (size_t idx = 0; idx < num_chans; idx++) {
+		struct morse_pwm_chan* c = &chans[idx];
+		int slot = gpio_batch_add(&s->batch, c->led);
+		if (slot < 0) {
+			return slot;
+		}
+		c->port_slot = (uint8_t)slot;
+		s->pins[slot] |= BIT(c->led->pin);
+
+		uint32_t unit_us = ((c->unit_ms != 0U) ? c->unit_ms : t_ms) * 1000U;
+		c->unit_frames = MAX(unit_us / s->frame_us, 1U);
+		c->key = false;
+		c->ramp_pos = 0;
+		c->frames_left = 1;  // first frame loads the first run
+		morse_bits_rewind(c->bits);
+	}
+
+	shell_pwm = s;
+	k_timer_init(&s->timer, morse_pwm_tick, NULL);
+	k_timer_start(&s->timer, K_TICKS(step_ticks), K_TICKS(step_ticks));
+	return 0;
+}
+
+void morse_pwm_stop(struct morse_pwm* s) {
+	// Stop the timer; LEDs stay at whatever level they were at.
+	k_timer_stop(&s->timer);
+}
+
+/* --- Shell: morse pwm [<chan> <brightness %> [<ramp ms>]] --- */
+
+static int cmd_morse_pwm(const struct shell* sh, size_t argc, char** argv)
+{
+	struct morse_pwm* s = shell_pwm;
+
+	if (s == NULL) {
+		shell_error(sh, "PWM engine not running");
+		return -ENODEV;
+	}
+
+	if (argc > 1) {
+		char* end;
+		unsigned long chan = strtoul(argv[1], &end, 10);
+		unsigned long percent = (argc > 2) ? strtoul(argv[2], NULL, 10) : 100U;
+
+		if (*end != '\0' || chan >= s->num_chans || percent > 100U) {
+			shell_error(sh, "usage: pwm <chan 0..%u> <brightness 0..100 %%> [<ramp ms>]",
+			            (unsigned)s->num_chans - 1U);
+			return -EINVAL;
+		}
+		s->chans[chan].brightness = (uint8_t)((percent * MORSE_PWM_STEPS + 50U) / 100U);
+		if (argc > 3) {
+			unsigned long frames = strtoul(argv[3], NULL, 10) * 1000U / s->frame_us;
+			s->chans[chan].ramp_frames = (uint8_t)MIN(frames, UINT8_MAX);
+		}
+	}
+
+	for (size_t idx = 0; idx < s->num_chans; idx++) {
+		const struct morse_pwm_chan* c = &s->chans[idx];
+		shell_print(sh, "chan %u: brightness %u/%u, ramp %u ms", (unsigned)idx, c->brightness,
+		            MORSE_PWM_STEPS, c->ramp_frames * s->frame_us / 1000U);
+	}
+	shell_print(sh, "frame %u us, %u frames, %u port writes", s->frame_us, s->frames, s->writes);
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), pwm, NULL, "Brightness and fades: pwm [<chan> <brightness %> [<ramp ms>]]",
+                 cmd_morse_pwm, 1, 3);
+
+#endif /* MORSE_PWM_H */
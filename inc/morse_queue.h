@@ -0,0 +1,102 @@
+#ifndef MORSE_QUEUE_H
+#define MORSE_QUEUE_H
+
+#include <string.h>            // memcpy()
+#include <zephyr/sys/atomic.h> // atomic_t, atomic_cas()
+
+/*
+ * Bounded lock-free queue of "LED n should now send this text" updates.
+ *
+ * Producers are the input paths (shell thread, UART interrupt); the consumer
+ * is the thread that hands new messages to the LEDs. Nobody ever waits on a
+ * lock: a full queue just makes morse_queue_push() fail, so input can never
+ * hold up playback.
+ *
+ * Each slot has a sequence number that says whose turn it is (producer or
+ * consumer), the usual bounded MPMC ring. A burst of updates is pushed as ONE
+ * batch: the producer reserves all its slots at once, so the updates stay
+ * together in the queue and the last one is flagged. The consumer applies a
+ * batch only when it has seen that flag.
+ */
+
+#define MORSE_MSG_MAX     48  // longest text per update (chars)
+#define MORSE_QUEUE_LEN   16  // slots, must be a power of two
+
+struct morse_update {
+	uint8_t chan;                     // which LED
+	uint8_t last;                     // 1 = last update of its batch
+	char text[MORSE_MSG_MAX + 1];     // NUL terminated
+};
+
+struct morse_queue {
+	struct {
+		atomic_t seq;                 // == position: free for producer, == position + 1: full
+		struct morse_update upd;
+	} slots[MORSE_QUEUE_LEN];
+	atomic_t tail;                    // next position producers reserve
+	atomic_t head;                    // next position the consumer reads
+};
+
+void morse_queue_init(struct morse_queue* q) {
+	// Must be called before any push/pop.
+	for (size_t idx = 0; idx < MORSE_QUEUE_LEN; idx++) {
+		atomic_set(&q->slots[idx].seq, (atomic_val_t)idx);
+	}
+	atomic_set(&q->tail, 0);
+	atomic_set(&q->head, 0);
+}
+
+int morse_queue_push(struct morse_queue* q, struct morse_update* upds, size_t count) {
+	// Push count updates as one batch (safe from threads and ISRs at the same time).
+	// Marks the last one with last = 1.
+	// Returns: 0, -EINVAL for an empty/too big batch, -ENOMEM if the queue is full.
+
+	atomic_val_t pos;
+
+	if (count == 0 || count > MORSE_QUEUE_LEN) {
+		return -EINVAL;
+	}
+
+	/* Reserve count slots in a row, or give up if they are not all free. */
+	for (;;) {
+		pos = atomic_get(&q->tail);
+
+		atomic_val_t last_seq = atomic_get(&q->slots[((size_t)pos + count - 1) & (MORSE_QUEUE_LEN - 1)].seq);
+		if ((atomic_val_t)(last_seq - (pos + (atomic_val_t)count - 1)) < 0) {
+			return -ENOMEM;  // consumer has not freed them yet
+		}
+		if (last_seq == pos + (atomic_val_t)count - 1 && atomic_cas(&q->tail, pos, pos + (atomic_val_t)count)) {
+			break;  // they are ours
+		}
+		/* another producer got there first, try again */
+	}
+
+	/* Fill and publish each slot. */
+	for (size_t i = 0; i < count; i++) {
+		atomic_val_t p = pos + (atomic_val_t)i;
+
+		upds[i].last = (i + 1 == count);
+		memcpy(&q->slots[(size_t)p & (MORSE_QUEUE_LEN - 1)].upd, &upds[i], sizeof(upds[i]));
+		atomic_set(&q->slots[(size_t)p & (MORSE_QUEUE_LEN - 1)].seq, p + 1);
+	}
+	return 0;
+}
+
+bool morse_queue_pop(struct morse_queue* q, struct morse_update* out) {
+	// Take the oldest update (only ONE consumer thread may call this).
+	// Returns: true if *out was filled, false if the queue is empty.
+
+	atomic_val_t pos = atomic_get(&q->head);
+	size_t idx = (size_t)pos & (MORSE_QUEUE_LEN - 1);
+
+	if (atomic_get(&q->slots[idx].seq) != pos + 1) {
+		return false;  // empty, or the producer is still filling it
+	}
+
+	memcpy(out, &q->slots[idx].upd, sizeof(*out));
+	atomic_set(&q->slots[idx].seq, pos + MORSE_QUEUE_LEN);  // free for the next lap
+	atomic_set(&q->head, pos + 1);
+	return true;
+}
+
+#endif /* MORSE_QUEUE_H */
@@ -0,0 +1,236 @@
+#ifndef MORSE_RX_H
+#define MORSE_RX_H
+
+#include <zephyr/kernel.h>        // k_sem, k_cycle_get_32()
+#include <zephyr/drivers/gpio.h>  // gpio_callback, gpio_pin_interrupt_configure_dt()
+#include <zephyr/sys/atomic.h>    // atomic_t
+#include <morse.h>                // morse_table[], MORSE_*_UNITS
+
+/*
+ * Morse receiver: GPIO input -> text.
+ *
+ * 1) The GPIO interrupt (both edges) only writes "(time, new level)" into a
+ *    small ring and wakes the decoder thread. No polling, a few instructions
+ *    per edge, so it keeps up however fast the sender is.
+ *
+ * 2) The decoder thread turns each ON time (mark) and OFF time (space) into
+ *    Morse, measured against its current guess of the unit T:
+ *      mark  < 2T : dot          mark  >= 2T : dash
+ *      space < 2T : same letter  space <  5T : next letter   else : next word
+ *    Every mark and space also nudges the guess (moving average, 1/4 weight),
+ *    so it follows a sender that speeds up or slows down. A mark far outside
+ *    the expected range (> 5T or < T/2) resets the guess at once.
+ *
+ * 3) Elements are shifted into the same sentinel-packed byte morse_table[]
+ *    uses, so a finished letter is one lookup in morse_rx_table[] (the table
+ *    inverted). Walking bit by bit down that byte is the usual Morse binary
+ *    tree, flattened into an array.
+ *
+ * When the line stays OFF for a word gap, the last letter and a ' ' are
+ * delivered without waiting for the next edge.
+ *
+ *   static void got_char(struct morse_rx* rx, char c) { ... }
+ *   morse_rx_init(&rx, &rx_pin, 60, got_char);
+ *   for (;;) { morse_rx_process(&rx); }   // in its own thread
+ */
+
+#define MORSE_RX_EDGES 64  // edges the ISR can queue, must be a power of two
+
+struct morse_rx;
+typedef void (*morse_rx_char_cb)(struct morse_rx* rx, char c);
+
+struct morse_rx_edge {
+	uint32_t t;      // k_cycle_get_32() when the line changed
+	uint8_t level;   // level after the change
+};
+
+struct morse_rx {
+	const struct gpio_dt_spec* in;    // input pin
+	struct gpio_callback cb;
+	morse_rx_char_cb on_char;         // gets every decoded character
+
+	/* ISR -> thread: single producer, single consumer ring */
+	struct morse_rx_edge edges[MORSE_RX_EDGES];
+	atomic_t head;                    // next slot the ISR writes
+	atomic_t tail;                    // next slot the thread reads
+	uint32_t overruns;                // edges dropped because the ring was full
+	struct k_sem wake;
+
+	/* decoder state (thread only) */
+	uint32_t unit;                    // current guess of T, in cycles
+	uint32_t last_t;                  // time of the previous edge
+	uint8_t level;                    // line level since last_t
+	bool idle;                        // word already finished by the timeout
+	uint8_t elems;                    // elements of the letter so far (bit 0 = first, 1 = dash)
+	uint8_t num_elems;
+};
+
+/* morse_table[] inverted: sentinel-packed code -> character (0 = unknown). */
+static char morse_rx_table[256];
+
+/* Fill morse_rx_table[] once. Upper case wins over lower case, the first character wins over aliases. */
+static void morse_rx_build_table(void)
+{
+	for (size_t c = 0; c < ARRAY_SIZE(morse_table); c++) {
+		uint8_t code = morse_table[c];
+
+		if (code <= MORSE_CODE_SPACE || (c >= 'a' && c <= 'z') || morse_rx_table[code] != 0) {
+			continue;
+		}
+		morse_rx_table[code] = (char)c;
+	}
+}
+
+/* GPIO interrupt: timestamp the edge and hand it to the thread. */
+static void morse_rx_isr(const struct device* port, struct gpio_callback* cb, gpio_port_pins_t pins)
+{
+	struct morse_rx* rx = CONTAINER_OF(cb, struct morse_rx, cb);
+	uint32_t t = k_cycle_get_32();
+	atomic_val_t head = atomic_get(&rx->head);
+
+	ARG_UNUSED(port);
+	ARG_UNUSED(pins);
+
+	if (head - atomic_get(&rx->tail) == MORSE_RX_EDGES) {
+		rx->overruns++;  // thread is behind; losing an edge beats blocking here
+		return;
+	}
+	rx->edges[(size_t)head & (MORSE_RX_EDGES - 1)].t = t;
+	rx->edges[(size_t)head & (MORSE_RX_EDGES - 1)].level = (uint8_t)(gpio_pin_get_dt(rx->in) > 0);
+	atomic_set(&rx->head, head + 1);
+	k_sem_give(&rx->wake);
+}
+
+/* Move the unit guess a quarter of the way towards sample. */
+static inline void morse_rx_adapt(struct morse_rx* rx, uint32_t sample)
+{
+	rx->unit = rx->unit - rx->unit / 4U + sample / 4U;
+}
+
+/* The letter is complete: look it up and deliver it. */
+static void morse_rx_end_letter(struct morse_rx* rx)
+{
+	if (rx->num_elems == 0U) {
+		return;
+	}
+	char c = (rx->num_elems <= MORSE_MAX_ELEMENTS)
+	         ? morse_rx_table[rx->elems | (1U << rx->num_elems)] : 0;
+
+	rx->on_char(rx, (c != 0) ? c : '?');
+	rx->elems = 0;
+	rx->num_elems = 0;
+}
+
+/* The line was ON for d cycles. */
+static void morse_rx_mark(struct morse_rx* rx, uint32_t d)
+{
+	bool dash;
+
+	if (d > 5U * rx->unit) {
+		rx->unit = d / MORSE_DASH_UNITS;  // much slower sender than we thought
+		dash = true;
+	} else if (d < rx->unit / 2U) {
+		rx->unit = d;                     // much faster sender
+		dash = false;
+	} else {
+		dash = (d >= 2U * rx->unit);
+		morse_rx_adapt(rx, dash ? d / MORSE_DASH_UNITS : d);
+	}
+
+	if (rx->num_elems < 8U) {
+		rx->elems |= (uint8_t)(dash ? 1U : 0U) << rx->num_elems;
+	}
+	rx->num_elems++;  // more than MORSE_MAX_ELEMENTS decodes as '?'
+}
+
+/* The line was OFF for d cycles. */
+static void morse_rx_space(struct morse_rx* rx, uint32_t d)
+{
+	if (d < 2U * rx->unit) {
+		morse_rx_adapt(rx, d);  // gap inside a letter
+	} else if (d < 5U * rx->unit) {
+		morse_rx_adapt(rx, d / MORSE_LETTER_GAP_UNITS);
+		morse_rx_end_letter(rx);
+	} else {
+		morse_rx_end_letter(rx);
+		rx->on_char(rx, ' ');
+	}
+}
+
+int morse_rx_init(struct morse_rx* rx, const struct gpio_dt_spec* in, uint32_t unit_ms, morse_rx_char_cb on_char) {
+	// Start receiving on pin in (configured here as an input with an interrupt on both edges).
+	// unit_ms is the first guess of T; it adapts to the real sender from the first marks on.
+	// Returns: 0 on success, -ENODEV if the GPIO is not ready, or a GPIO error code.
+
+	int ret;
+
+	if (!gpio_is_ready_dt(in)) {
+		return -ENODEV;
+	}
+	if (morse_rx_table['E'] == 0) {
+		morse_rx_build_table();
+	}
+
+	rx->in = in;
+	rx->on_char = on_char;
+	atomic_set(&rx->head, 0);
+	atomic_set(&rx->tail, 0);
+	rx->overruns = 0;
+	k_sem_init(&rx->wake, 0, K_SEM_MAX_LIMIT);
+
+	rx->unit = (uint32_t)k_ms_to_cyc_ceil32(unit_ms);
+	rx->level = 0;
+	rx->idle = true;  // nothing to finish before the first mark
+	rx->elems = 0;
+	rx->num_elems = 0;
+
+	ret = gpio_pin_configure_dt(in, GPIO_INPUT);
+	if (ret < 0) {
+		return ret;
+	}
+	gpio_init_callback(&rx->cb, morse_rx_isr, BIT(in->pin));
+	ret = gpio_add_callback(in->port, &rx->cb);
+	if (ret < 0) {
+		return ret;
+	}
+	return gpio_pin_interrupt_configure_dt(in, GPIO_INT_EDGE_BOTH);
+}
+
+void morse_rx_process(struct morse_rx* rx) {
+	// Decoder thread body: wait for edges (or a word gap of silence), decode them.
+	// Call it in a loop; characters come out through on_char.
+
+	k_timeout_t timeout = rx->idle ? K_FOREVER : K_CYC(MORSE_WORD_GAP_UNITS * rx->unit);
+
+	if (k_sem_take(&rx->wake, timeout) == -EAGAIN) {
+		/* Silence for a whole word gap: finish the word now. */
+		if (rx->level == 0U) {
+			morse_rx_end_letter(rx);
+			rx->on_char(rx, ' ');
+			rx->idle = true;
+		}
+		return;
+	}
+
+	while (atomic_get(&rx->tail) != atomic_get(&rx->head)) {
+		atomic_val_t tail = atomic_get(&rx->tail);
+		struct morse_rx_edge e = rx->edges[(size_t)tail & (MORSE_RX_EDGES - 1)];
+		uint32_t d = e.t - rx->last_t;  // wraps correctly
+
+		atomic_set(&rx->tail, tail + 1);
+		if (e.level == rx->level) {
+			continue;  // glitch or a missed edge, nothing to measure
+		}
+
+		if (e.level == 0U) {
+			morse_rx_mark(rx, d);
+		} else if (!rx->idle) {
+			morse_rx_space(rx, d);
+		}
+		rx->idle = false;
+		rx->level = e.level;
+		rx->last_t = e.t;
+	}
+}
+
+#endif /* MORSE_RX_H */
@@ -0,0 +1,196 @@
+#ifndef MORSE_SCHED_H
+#define MORSE_SCHED_H
+
+#include <zephyr/kernel.h>        // k_timer, k_uptime_ticks()
+#include <zephyr/drivers/gpio.h>  // struct gpio_dt_spec
+#include <gpio_batch.h>           // all edges due at the same time -> one write per port
+#include <morse_bits.h>           // bit-packed messages streamed run by run
+#include <edge_trace.h>           // every edge -> trace ring ("morse trace dump")
+
+/*
+ * One-timer Morse scheduler.
+ *
+ * Instead of one thread (and one 1 KB stack) per LED, every LED is a small
+ * "channel" struct that remembers where it is in its timeline and when its
+ * next edge is due. All channels sit in one min-heap ordered by that time,
+ * and a single k_timer is always armed for the earliest edge of ANY channel:
+ *
+ *   timer fires -> set every LED whose edge is due -> re-arm for the next one
+ *
+ * So there is one wakeup per edge no matter how many LEDs there are, and each
+ * extra LED costs sizeof(struct morse_chan) + 1 byte of RAM. LEDs whose edges
+ * land on the same tick are written together, one masked write per GPIO port.
+ *
+ * The timer callback runs in interrupt context, so the LEDs must be on a GPIO
+ * controller that can be written from an ISR (SoC GPIO, the native_sim emulator).
+ *
+ * Low power: with slack_ticks > 0 every edge due within that window after the
+ * first one is played in the same wakeup (a little early). LEDs at different
+ * speeds then share wakeups instead of each waking the CPU for itself; the
+ * schedule itself does not shift, only those edges.
+ */
+
+#define MORSE_SCHED_MAX_CHANS 64
+
+/*
+ * One LED and what it is playing: either a timeline (units) or, if bits is
+ * set, a bit-packed message that is streamed one run at a time.
+ */
+struct morse_chan {
+	const struct gpio_dt_spec* led;  // which LED
+	const uint8_t* units;            // ON/OFF timeline in units of T (see morse_timeline.h)
+	size_t num_units;                // entries in units[] (always even)
+	struct morse_bits_reader* bits;  // bitstream source instead of units (NULL = use units)
+	uint32_t unit_ms;                // this channel's T in ms (0 = the scheduler's T)
+	size_t pos;                      // next entry to start (even = ON, odd = OFF)
+	int64_t next_edge;               // absolute time of the next edge (ticks)
+	k_ticks_t unit_ticks;            // this channel's T in ticks (set by morse_sched_start())
+	uint8_t port_slot;               // this LED's port in morse_sched.batch
+};
+
+struct morse_sched {
+	struct k_timer timer;                   // the only timer for all channels
+	struct morse_chan* chans;               // channel array (owned by the caller)
+	size_t num_chans;
+	k_ticks_t unit_ticks;                   // default length of T in ticks
+	struct gpio_batch batch;                // pin changes of the current wakeup
+	k_ticks_t slack_ticks;                  // edges this close together share a wakeup (set before start)
+	uint32_t wakeups;                       // timer expiries so far
+	uint32_t edges;                         // LED edges played so far
+	uint8_t heap[MORSE_SCHED_MAX_CHANS];    // channel indices, earliest next_edge on top
+};
+
+/* --- min-heap of channel indices, keyed by next_edge --- */
+
+static inline bool morse_sched_before(const struct morse_sched* s, uint8_t a, uint8_t b)
+{
+	return s->chans[a].next_edge < s->chans[b].next_edge;
+}
+
+static inline void morse_sched_sift_down(struct morse_sched* s, size_t i)
+{
+	for (;;) {
+		size_t l = 2U * i + 1U;
+		size_t r = l + 1U;
+		size_t min = i;
+
+		if (l < s->num_chans && morse_sched_before(s, s->heap[l], s->heap[min])) {
+			min = l;
+		}
+		if (r < s->num_chans && morse_sched_before(s, s->heap[r], s->heap[min])) {
+			min = r;
+		}
+		if (min == i) {
+			return;
+		}
+
+		uint8_t tmp = s->heap[i];
+		s->heap[i] = s->heap[min];
+		s->heap[min] = tmp;
+		i = min;
+	}
+}
+
+/* Play the next run of a bitstream channel; at the end of the message it starts over. */
+static inline void morse_sched_step_bits(struct morse_sched* s, struct morse_chan* c)
+{
+	bool on;
+	uint32_t run = morse_bits_next_run(c->bits, &on);
+
+	if (run == 0U) {
+		morse_bits_rewind(c->bits);
+		run = morse_bits_next_run(c->bits, &on);
+	}
+	gpio_batch_set_pin(&s->batch, c->port_slot, c->led->pin, on);
+	edge_trace_record((uint8_t)(c - s->chans), on, k_ticks_to_cyc_floor32(c->next_edge));
+	c->next_edge += run * c->unit_ticks;
+}
+
+/* Play the next timeline entry of channel c: queue the LED level and work out the following edge. */
+static inline void morse_sched_step(struct morse_sched* s, struct morse_chan* c)
+{
+	if (c->bits != NULL) {
+		morse_sched_step_bits(s, c);
+		return;
+	}
+
+	/* even entries are ON, odd are OFF */
+	bool on = (c->pos & 1U) == 0U;
+
+	gpio_batch_set_pin(&s->batch, c->port_slot, c->led->pin, on);
+	edge_trace_record((uint8_t)(c - s->chans), on, k_ticks_to_cyc_floor32(c->next_edge));
+	c->next_edge += c->units[c->pos] * c->unit_ticks;
+
+	c->pos++;
+	if (c->pos == c->num_units) {
+		c->pos = 0;  // word finished (its 7T gap included), start over
+	}
+}
+
+/* k_timer callback: every channel that is due gets its edge, then re-arm once. */
+static void morse_sched_expiry(struct k_timer* timer)
+{
+	struct morse_sched* s = CONTAINER_OF(timer, struct morse_sched, timer);
+	int64_t due = s->chans[s->heap[0]].next_edge + s->slack_ticks;
+
+	/* Several LEDs can share the same edge time (or slack window); handle them all in this wakeup. */
+	s->wakeups++;
+	while (s->chans[s->heap[0]].next_edge <= due) {
+		morse_sched_step(s, &s->chans[s->heap[0]]);
+		morse_sched_sift_down(s, 0);
+		s->edges++;
+	}
+	gpio_batch_flush(&s->batch);  // all of them switch together
+
+	k_timer_start(&s->timer, K_TIMEOUT_ABS_TICKS(s->chans[s->heap[0]].next_edge), K_NO_WAIT);
+}
+
+int morse_sched_start(struct morse_sched* s, struct morse_chan* chans, size_t num_chans, uint32_t t_ms) {
+	// Start playing every channel from the beginning of its timeline.
+	// All LEDs start together, t_ms is the Morse unit T in milliseconds for
+	// every channel that does not set its own unit_ms.
+	// Returns: 0 on success, -EINVAL if there are no/too many channels,
+	//          -ENOMEM if the LEDs are spread over too many GPIO ports.
+
+	if (num_chans == 0 || num_chans > MORSE_SCHED_MAX_CHANS) {
+		return -EINVAL;
+	}
+
+	s->chans = chans;
+	s->num_chans = num_chans;
+	s->unit_ticks = k_ms_to_ticks_ceil64(t_ms);
+	s->batch.num_ports = 0;
+	s->wakeups = 0;
+	s->edges = 0;
+
+	/* Everyone starts one unit from now, so the heap is trivially ordered. */
+	int64_t start = k_uptime_ticks() + s->unit_ticks;
+	for (size_t idx = 0; idx < num_chans; idx++) {
+		int slot = gpio_batch_add(&s->batch, chans[idx].led);
+		if (slot < 0) {
+			return slot;
+		}
+		chans[idx].port_slot = (uint8_t)slot;
+		chans[idx].unit_ticks = s->unit_ticks;
+		if (chans[idx].unit_ms != 0U) {
+			chans[idx].unit_ticks = k_ms_to_ticks_ceil64(chans[idx].unit_ms);  // its own speed
+		}
+		chans[idx].pos = 0;
+		if (chans[idx].bits != NULL) {
+			morse_bits_rewind(chans[idx].bits);
+		}
+		chans[idx].next_edge = start;
+		s->heap[idx] = (uint8_t)idx;
+	}
+
+	k_timer_init(&s->timer, morse_sched_expiry, NULL);
+	k_timer_start(&s->timer, K_TIMEOUT_ABS_TICKS(start), K_NO_WAIT);
+	return 0;
+}
+
+void morse_sched_stop(struct morse_sched* s) {
+	// Stop the timer; LEDs stay at whatever level they were at.
+	k_timer_stop(&s->timer);
+}
+
+#endif /* MORSE_SCHED_H */
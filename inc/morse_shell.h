@@ -0,0 +1,18 @@
+#ifndef MORSE_SHELL_H
+#define MORSE_SHELL_H
+
+#include <zephyr/shell/shell.h>  // SHELL_SUBCMD_SET_CREATE(), SHELL_CMD_REGISTER()
+
+/*
+ * The "morse" shell command. It has no handler of its own; each module adds
+ * its subcommands with
+ *
+ *   SHELL_SUBCMD_ADD((morse), name, &sub_name, "help", handler, mandatory, optional);
+ *
+ * so a variant only gets the subcommands of the modules it includes.
+ */
+
+SHELL_SUBCMD_SET_CREATE(sub_morse, (morse));
+SHELL_CMD_REGISTER(morse, &sub_morse, "Morse LED commands", NULL);
+
+#endif /* MORSE_SHELL_H */
@@ -0,0 +1,73 @@
+#ifndef MORSE_SLOT_H
+#define MORSE_SLOT_H
+
+#include <stddef.h>             // size_t
+#include <zephyr/sys/atomic.h>  // atomic_ptr_t, atomic_ptr_set()
+
+/*
+ * Double-buffered message slot: swap an LED's message while it is playing.
+ *
+ * Each LED owns two message buffers. The LED plays one of them; the writer
+ * fills the other and publishes it by storing its pointer in "pending".
+ * Between two words the LED swaps "pending" with NULL; if it got a pointer,
+ * that is its new message. Nobody locks, nobody waits, nobody copies, and a
+ * word is never cut in half because the LED only looks at word boundaries.
+ *
+ * Which buffer may the writer use? The one the LED is NOT playing:
+ *   - if the last published message is still pending, take it back (swap
+ *     pending with NULL) and overwrite it, the LED never saw it;
+ *   - otherwise the LED has taken the last one, so the other buffer is free.
+ *
+ * Whatever can fail (e.g. encoding a text that does not fit) belongs BEFORE
+ * morse_slot_prepare(): a message taken back and then not published is
+ * lost, and the LED keeps playing the one before it.
+ *
+ * Rules: ONE writer per slot, ONE player per slot.
+ */
+
+#define MORSE_SLOT_BYTES 128  // bitstream bytes per message (1 bit per T)
+
+struct morse_msg {
+	size_t nbits;                     // message length in units (bits)
+	uint8_t bits[MORSE_SLOT_BYTES];   // see morse_bits.h
+};
+
+struct morse_slot {
+	struct morse_msg buf[2];
+	atomic_ptr_t pending;             // published but not taken yet (or NULL)
+	struct morse_msg* last;           // buffer the LED may be playing (writer only)
+};
+
+/* The buffer of the pair that is not msg. */
+static inline struct morse_msg* morse_slot_other(struct morse_slot* slot, const struct morse_msg* msg)
+{
+	return (msg == &slot->buf[0]) ? &slot->buf[1] : &slot->buf[0];
+}
+
+struct morse_msg* morse_slot_prepare(struct morse_slot* slot) {
+	// Writer: get the buffer to write the next message into.
+	// A message that was published but not picked up yet is taken back.
+
+	struct morse_msg* taken_back = atomic_ptr_set(&slot->pending, NULL);
+
+	if (taken_back != NULL) {
+		/* LED never saw it, safe to reuse; the LED is still on the other one. */
+		slot->last = morse_slot_other(slot, taken_back);
+		return taken_back;
+	}
+	return morse_slot_other(slot, slot->last);
+}
+
+void morse_slot_publish(struct morse_slot* slot, struct morse_msg* msg) {
+	// Writer: hand msg (from morse_slot_prepare()) to the LED.
+	slot->last = msg;
+	atomic_ptr_set(&slot->pending, msg);
+}
+
+/* Player, between two words: the new message, or NULL to keep the current one. */
+static inline struct morse_msg* morse_slot_take(struct morse_slot* slot)
+{
+	return atomic_ptr_set(&slot->pending, NULL);
+}
+
+#endif /* MORSE_SLOT_H */
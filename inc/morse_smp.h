@@ -0,0 +1,99 @@
+#ifndef MORSE_SMP_H
+#define MORSE_SMP_H
+
+#include <zephyr/kernel.h>        // k_thread_cpu_pin(), k_thread_runtime_stats_cpu_get()
+#include <zephyr/sys/util.h>      // IS_ENABLED()
+#include <zephyr/shell/shell.h>   // shell_print()
+#include <morse_shell.h>          // the "morse" command
+
+/*
+ * Multi-core: which CPU the LED threads run on, and how busy every CPU is.
+ *
+ * -DMORSE_SMP=ON (smp.conf) turns on SMP with two CPUs; every thread may run
+ * on either, wherever the scheduler finds room. The LED threads then share
+ * both CPUs (and their caches and interrupt load) with main(), the shell, the
+ * telemetry work queue and the "morse load" thread.
+ *
+ * -DMORSE_SMP_PIN=ON (smp_pin.conf) adds CONFIG_SCHED_CPU_MASK_PIN_ONLY:
+ * every thread starts pinned to CPU 0, and morse_smp_pin_led() moves the LED
+ * threads to MORSE_SMP_LED_CPU before they start. That CPU then runs the LED
+ * threads and nothing else; input, telemetry and load stay on CPU 0.
+ *
+ *   uart:~$ morse cpu         busy time of every CPU since the last look
+ *
+ * Every caller of morse_smp_busy() keeps its own struct morse_smp_window, so
+ * "morse cpu" and a periodic report each measure since their own last look.
+ *
+ * Per-CPU time needs CONFIG_SCHED_THREAD_USAGE_ALL (in smp.conf).
+ */
+
+#define MORSE_SMP_LED_CPU 1  // CPU the LED threads get to themselves (pinned mode)
+
+#ifdef CONFIG_MP_MAX_NUM_CPUS
+#define MORSE_SMP_CPUS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define MORSE_SMP_CPUS 1
+#endif
+
+int morse_smp_pin_led(k_tid_t thread) {
+	// Pinned mode: put an LED thread on MORSE_SMP_LED_CPU. The thread must not
+	// have started yet (create it with K_FOREVER, then k_thread_start()).
+	// Returns: 0 (also when not pinning), or the k_thread_cpu_pin() error.
+#if defined(MORSE_SMP_PIN) && defined(CONFIG_SCHED_CPU_MASK)
+	BUILD_ASSERT(MORSE_SMP_LED_CPU < MORSE_SMP_CPUS, "pinned mode needs a second CPU");
+	return k_thread_cpu_pin(thread, MORSE_SMP_LED_CPU);
+#else
+	ARG_UNUSED(thread);
+	return 0;
+#endif
+}
+
+/* Busy and total cycles of each CPU at one caller's last look (zero = since boot). */
+struct morse_smp_window {
+	uint64_t busy[MORSE_SMP_CPUS];
+	uint64_t total[MORSE_SMP_CPUS];
+};
+
+int morse_smp_busy(struct morse_smp_window* win, int cpu) {
+	// How busy cpu was since the previous call with the same win, in 0.1 % (0..1000).
+	// Returns: -EINVAL for a bad cpu, -ENOTSUP without per-CPU statistics.
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	k_thread_runtime_stats_t rt;
+
+	if (cpu < 0 || cpu >= MORSE_SMP_CPUS || k_thread_runtime_stats_cpu_get(cpu, &rt) != 0) {
+		return -EINVAL;
+	}
+	uint64_t busy = rt.total_cycles - win->busy[cpu];                   // not in the idle thread
+	uint64_t total = rt.total_cycles + rt.idle_cycles - win->total[cpu];
+	win->busy[cpu] = rt.total_cycles;
+	win->total[cpu] = rt.total_cycles + rt.idle_cycles;
+	return (total != 0U) ? (int)(busy * 1000U / total) : 0;
+#else
+	ARG_UNUSED(win);
+	ARG_UNUSED(cpu);
+	return -ENOTSUP;
+#endif
+}
+
+static int cmd_morse_cpu(const struct shell* sh, size_t argc, char** argv)
+{
+	static struct morse_smp_window win;  // the shell's own, apart from any report
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int cpu = 0; cpu < MORSE_SMP_CPUS; cpu++) {
+		int busy = morse_smp_busy(&win, cpu);
+		if (busy < 0) {
+			shell_error(sh, "no per-CPU statistics in this build (-DMORSE_SMP=ON)");
+			return busy;
+		}
+		shell_print(sh, "cpu %d: %d.%d %% busy%s", cpu, busy / 10, busy % 10,
+		            (IS_ENABLED(MORSE_SMP_PIN) && cpu == MORSE_SMP_LED_CPU) ? " (LED threads only)" : "");
+	}
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), cpu, NULL, "Busy time of every CPU since the last look", cmd_morse_cpu, 1, 0);
+
+#endif /* MORSE_SMP_H */
@@ -0,0 +1,94 @@
+#ifndef MORSE_SPEED_H
+#define MORSE_SPEED_H
+
+#include <stdint.h>   // uint32_t
+#include <errno.h>    // EINVAL
+#include <morse.h>    // MORSE_*_UNITS
+
+/*
+ * Morse speed in words per minute, with optional Farnsworth spacing.
+ *
+ * WPM is measured with the standard word "PARIS " = 50 units, so
+ *
+ *   T = 60 s / (50 * WPM) = 1 200 000 us / WPM      (20 WPM -> T = 60 ms)
+ *
+ * Farnsworth: letters are sent at the fast "character speed" wpm, but the
+ * gaps between letters and words are stretched so the text as a whole comes
+ * out at the slower "overall speed" fwpm. Of the 50 units of PARIS, 31 are
+ * the letters themselves and 19 are letter/word gaps (4 x 3 + 7); only those
+ * 19 get longer:
+ *
+ *   gap unit = (60 s / fwpm - 31 T) / 19
+ *
+ * Everything is in microseconds, so units well below 1 ms (> 1200 WPM) work.
+ * No Zephyr includes: the host tools use this too.
+ *
+ * The stretching is for Morse only: morse_speed_off_us() takes any 3T or 7T
+ * dark run for a letter or word gap. A line-coded frame (morse_line.h) has
+ * 3T and 7T runs of zero bits in its data, so it must be timed with
+ * morse_speed_plain_us() for every run.
+ */
+
+#define MORSE_PARIS_UNITS      50U  // one standard word, gaps included
+#define MORSE_PARIS_GAP_UNITS  19U  // of which letter + word gaps
+
+struct morse_speed {
+	uint32_t unit_us;          // T: dot, dash = 3T, gap inside a letter
+	uint32_t letter_gap_us;    // 3T, or longer with Farnsworth
+	uint32_t word_gap_us;      // 7T, or longer with Farnsworth
+};
+
+/* Both speeds in one 32-bit word, so they can be swapped atomically (fwpm 0 = no Farnsworth). */
+#define MORSE_SPEED_PACK(wpm, fwpm) (((uint32_t)(wpm) << 16) | ((uint32_t)(fwpm) & 0xFFFFU))
+#define MORSE_SPEED_WPM(packed)     ((uint32_t)(packed) >> 16)
+#define MORSE_SPEED_FWPM(packed)    ((uint32_t)(packed) & 0xFFFFU)
+
+int morse_speed_set(struct morse_speed* sp, uint32_t wpm, uint32_t fwpm) {
+	// Work out the timing for character speed wpm and overall speed fwpm.
+	// fwpm = 0 (or >= wpm) means plain timing, no Farnsworth.
+	// Returns: 0, or -EINVAL if the speed is 0 or too fast for 1 us resolution.
+
+	if (wpm == 0U || wpm > 1200000U) {
+		return -EINVAL;
+	}
+
+	sp->unit_us = 1200000U / wpm;
+	sp->letter_gap_us = MORSE_LETTER_GAP_UNITS * sp->unit_us;
+	sp->word_gap_us = MORSE_WORD_GAP_UNITS * sp->unit_us;
+
+	if (fwpm != 0U && fwpm < wpm) {
+		uint64_t word_us = 60000000ULL / fwpm;
+		uint64_t letters_us = (uint64_t)(MORSE_PARIS_UNITS - MORSE_PARIS_GAP_UNITS) * sp->unit_us;
+		uint64_t gap_unit_us = (word_us - letters_us) / MORSE_PARIS_GAP_UNITS;
+
+		sp->letter_gap_us = (uint32_t)(MORSE_LETTER_GAP_UNITS * gap_unit_us);
+		sp->word_gap_us = (uint32_t)(MORSE_WORD_GAP_UNITS * gap_unit_us);
+	}
+	return 0;
+}
+
+/* How long an ON run of units lasts. */
+static inline uint32_t morse_speed_on_us(const struct morse_speed* sp, uint32_t units)
+{
+	return units * sp->unit_us;
+}
+
+/* How long a run of units lasts with no Farnsworth stretching (content that is not Morse). */
+static inline uint32_t morse_speed_plain_us(const struct morse_speed* sp, uint32_t units)
+{
+	return units * sp->unit_us;
+}
+
+/* How long an OFF run of units of Morse lasts: letter and word gaps may be stretched (Farnsworth). */
+static inline uint32_t morse_speed_off_us(const struct morse_speed* sp, uint32_t units)
+{
+	if (units == MORSE_LETTER_GAP_UNITS) {
+		return sp->letter_gap_us;
+	}
+	if (units == MORSE_WORD_GAP_UNITS) {
+		return sp->word_gap_us;
+	}
+	return units * sp->unit_us;
+}
+
+#endif /* MORSE_SPEED_H */
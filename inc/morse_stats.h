@@ -0,0 +1,179 @@
+#ifndef MORSE_STATS_H
+#define MORSE_STATS_H
+
+#include <string.h>                // strcmp(), memset()
+#include <zephyr/kernel.h>         // k_thread_runtime_stats_get(), k_thread_stack_space_get()
+#include <zephyr/sys/byteorder.h>  // sys_put_le32(), sys_put_le16()
+#include <zephyr/sys/util.h>       // MIN()
+#include <zephyr/shell/shell.h>    // shell_print(), shell_hexdump()
+#include <morse_shell.h>           // the "morse" command
+
+/*
+ * Always-on health counters for the LED channels and their threads.
+ *
+ * Per channel (counted by the channel's own thread, so no locking):
+ *   words       word gaps sent (every repeat of a word, every word of a text)
+ *   edges       LED transitions
+ *   late        edges more than MORSE_STATS_LATE_US after their deadline
+ *   max_late    worst lateness seen, in us
+ * Per thread (from the kernel): CPU time since boot and stack high-water mark.
+ *
+ *   uart:~$ morse stats          as text
+ *   uart:~$ morse stats bin      packed snapshot, as hex (format below)
+ *   uart:~$ morse stats reset    channel counters back to 0 (CPU time is since boot)
+ *
+ * Snapshot, little endian, 12 + 16 * channels + 8 * threads bytes:
+ *   u8 version (1), u8 channels, u8 threads, u8 0, u32 uptime ms, u32 late threshold us
+ *   per channel: u32 words, u32 edges, u32 late, u32 max_late_us
+ *   per thread:  u32 cpu ms, u16 stack used, u16 stack size  (0 if not available)
+ *
+ * CPU time needs CONFIG_THREAD_RUNTIME_STATS, stack use CONFIG_INIT_STACKS and
+ * CONFIG_THREAD_STACK_INFO (all in prj.conf).
+ */
+
+#ifndef MORSE_STATS_LATE_US
+#define MORSE_STATS_LATE_US 1000  // an edge later than this counts as missed
+#endif
+
+#define MORSE_STATS_VERSION 1
+#define MORSE_STATS_MAX_BYTES 256  // snapshot buffer of "morse stats bin"
+
+struct morse_chan_stats {
+	uint32_t words;
+	uint32_t edges;
+	uint32_t late;
+	uint32_t max_late_us;
+};
+
+static struct morse_chan_stats* stats_chans;  // one per channel (owned by the program)
+static size_t stats_num_chans;
+static struct k_thread* stats_threads;        // the channels' threads (may be NULL)
+static size_t stats_num_threads;
+
+void morse_stats_init(struct morse_chan_stats* chans, size_t num_chans,
+                      struct k_thread* threads, size_t num_threads) {
+	// Register the counters (zeroed here) and the threads "morse stats" reports on.
+	memset(chans, 0, num_chans * sizeof(*chans));
+	stats_chans = chans;
+	stats_num_chans = num_chans;
+	stats_threads = threads;
+	stats_num_threads = num_threads;
+}
+
+/* Hot path: one edge of a channel, late_us after its deadline. */
+static inline void morse_stats_edge(struct morse_chan_stats* cs, uint32_t late_us)
+{
+	cs->edges++;
+	if (late_us > MORSE_STATS_LATE_US) {
+		cs->late++;
+	}
+	if (late_us > cs->max_late_us) {
+		cs->max_late_us = late_us;
+	}
+}
+
+/* Hot path: a channel finished a word (its word gap starts). */
+static inline void morse_stats_word(struct morse_chan_stats* cs)
+{
+	cs->words++;
+}
+
+/* CPU time (ms) and stack use of one thread; 0 for what the build cannot tell. */
+static void morse_stats_thread(struct k_thread* thread, uint32_t* cpu_ms, uint32_t* used, uint32_t* size)
+{
+	*cpu_ms = 0;
+	*used = 0;
+	*size = 0;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	k_thread_runtime_stats_t rt;
+	if (k_thread_runtime_stats_get(thread, &rt) == 0) {
+		*cpu_ms = (uint32_t)k_cyc_to_ms_near64(rt.execution_cycles);
+	}
+#endif
+#ifdef CONFIG_THREAD_STACK_INFO
+	size_t unused;
+	*size = (uint32_t)thread->stack_info.size;
+	if (k_thread_stack_space_get(thread, &unused) == 0) {
+		*used = *size - (uint32_t)unused;
+	}
+#endif
+}
+
+size_t morse_stats_pack(uint8_t* buf, size_t len) {
+	// Write the snapshot described above into buf.
+	// Returns: bytes written, 0 if buf is too small.
+
+	size_t need = 12U + 16U * stats_num_chans + 8U * stats_num_threads;
+	if (len < need || stats_num_chans > UINT8_MAX || stats_num_threads > UINT8_MAX) {
+		return 0;
+	}
+
+	buf[0] = MORSE_STATS_VERSION;
+	buf[1] = (uint8_t)stats_num_chans;
+	buf[2] = (uint8_t)stats_num_threads;
+	buf[3] = 0;
+	sys_put_le32((uint32_t)k_uptime_get(), &buf[4]);
+	sys_put_le32(MORSE_STATS_LATE_US, &buf[8]);
+
+	uint8_t* p = &buf[12];
+	for (size_t idx = 0; idx < stats_num_chans; idx++, p += 16) {
+		const struct morse_chan_stats* cs = &stats_chans[idx];
+		sys_put_le32(cs->words, &p[0]);
+		sys_put_le32(cs->edges, &p[4]);
+		sys_put_le32(cs->late, &p[8]);
+		sys_put_le32(cs->max_late_us, &p[12]);
+	}
+	for (size_t idx = 0; idx < stats_num_threads; idx++, p += 8) {
+		uint32_t cpu_ms, used, size;
+		morse_stats_thread(&stats_threads[idx], &cpu_ms, &used, &size);
+		sys_put_le32(cpu_ms, &p[0]);
+		sys_put_le16((uint16_t)MIN(used, UINT16_MAX), &p[4]);
+		sys_put_le16((uint16_t)MIN(size, UINT16_MAX), &p[6]);
+	}
+	return need;
+}
+
+static int cmd_morse_stats(const struct shell* sh, size_t argc, char** argv)
+{
+	if (stats_chans == NULL) {
+		shell_error(sh, "no statistics in this program");
+		return -ENODEV;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		memset(stats_chans, 0, stats_num_chans * sizeof(*stats_chans));
+		shell_print(sh, "channel counters reset");
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "bin") == 0) {
+		static uint8_t snap[MORSE_STATS_MAX_BYTES];
+		size_t n = morse_stats_pack(snap, sizeof(snap));
+		if (n == 0U) {
+			shell_error(sh, "snapshot does not fit in %u bytes", MORSE_STATS_MAX_BYTES);
+			return -ENOMEM;
+		}
+		shell_hexdump(sh, snap, n);
+		return 0;
+	}
+
+	uint32_t up_ms = (uint32_t)k_uptime_get();
+	for (size_t idx = 0; idx < stats_num_chans; idx++) {
+		const struct morse_chan_stats* cs = &stats_chans[idx];
+		shell_print(sh, "chan %u: %u words, %u edges, %u late (> %u us), worst %u us", (unsigned)idx,
+		            cs->words, cs->edges, cs->late, MORSE_STATS_LATE_US, cs->max_late_us);
+	}
+	for (size_t idx = 0; idx < stats_num_threads; idx++) {
+		uint32_t cpu_ms, used, size;
+		morse_stats_thread(&stats_threads[idx], &cpu_ms, &used, &size);
+		shell_print(sh, "thread %u: cpu %u ms (%u.%u%%), stack %u/%u bytes", (unsigned)idx, cpu_ms,
+		            (up_ms != 0U) ? (uint32_t)((uint64_t)cpu_ms * 100U / up_ms) : 0U,
+		            (up_ms != 0U) ? (uint32_t)((uint64_t)cpu_ms * 1000U / up_ms % 10U) : 0U, used, size);
+	}
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((morse), stats, NULL, "Channel and thread health: stats [bin|reset]", cmd_morse_stats, 1, 1);
+
+#endif /* MORSE_STATS_H */
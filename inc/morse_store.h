@@ -0,0 +1,400 @@
+#ifndef MORSE_STORE_H
+#define MORSE_STORE_H
+
+#include <stdlib.h>                     // strtoul()
+#include <string.h>                     // strcmp()
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>          // DT_CHOSEN()
+#include <zephyr/storage/flash_map.h>   // flash_area_open(), flash_area_write()
+#include <zephyr/sys/util.h>            // ROUND_UP()
+#include <zephyr/shell/shell.h>         // shell_print()
+#include <morse_shell.h>                // the "morse" command
+#include <morse_bits.h>                 // morse_bits_encode(), morse_bits_reader
+
+#if DT_HAS_COMPAT_STATUS_OKAY(zephyr_sim_flash)
+#include <zephyr/drivers/flash/flash_simulator.h>  // flash_simulator_get_memory()
+#endif
+
+/*
+ * Message store: pre-encoded Morse in a flash partition, played in place.
+ *
+ * The partition is the one chosen as "geoffcha,morse-store". It is a log of
+ * records, appended one after the other until the first erased header:
+ *
+ *   | magic "MS" | chan | 0 | nbits (32 bit) | bits ... | next record ...
+ *
+ * Header and bits each take a whole number of MORSE_STORE_ALIGN bytes: the
+ * flash's write block, at least 8 (so 8 + bits rounded up to 8 on native_sim).
+ *
+ * The bits are the same 1-bit-per-unit bitstream as morse_bits.h, encoded
+ * once when the message is added. A channel plays ALL its records in order,
+ * one after the other, then starts over, so it can have hundreds of long
+ * messages while using a few bytes of RAM: the player reads the bits straight
+ * out of the memory-mapped flash (morse_bits_reader with a fetch() that
+ * hops to the channel's next record). Nothing is copied, nothing is parsed
+ * at boot beyond walking the record headers once.
+ *
+ * The flash has to be memory-mapped: internal SoC flash, or the flash
+ * simulator on native_sim (kept in flash.bin between runs).
+ *
+ *   uart:~$ morse store                  records per channel, space left
+ *   uart:~$ morse store add 2 "cq cq de geoffcha"
+ *   uart:~$ morse store erase            empty the store at the next boot
+ *                                        (also what gets added after it)
+ *
+ * New records and the erase take effect at the next boot: the players only
+ * ever look at the records that were there when the store was loaded, so
+ * writing never races with playing. A record's header is written after its
+ * bits, so a write cut short by a reset is never played. The log ends there:
+ * morse_store_init() finds flash that is written but holds no record, and
+ * adding fails (-EIO) until "erase", whose record then goes in the first
+ * erased slot after the damage. The next boot finds it there and erases.
+ * If not even that record fits, morse_store_init() erases right away.
+ */
+
+#define MORSE_STORE_MAGIC 0x534DU        // "MS" in flash (little-endian)
+#define MORSE_STORE_MAX_BYTES 512U       // largest message "morse store add" encodes (4096 T)
+#define MORSE_STORE_CHAN_ERASE 0xFFU     // record that asks for an erase at the next boot
+
+#define MORSE_STORE_NODE DT_CHOSEN(geoffcha_morse_store)
+
+/* Records start on a flash write block, and never less than 8 bytes apart. */
+#define MORSE_STORE_WRITE_BLOCK DT_PROP_OR(DT_MTD_FROM_FIXED_PARTITION(MORSE_STORE_NODE), write_block_size, 1)
+#define MORSE_STORE_ALIGN MAX(8U, (size_t)MORSE_STORE_WRITE_BLOCK)
+
+struct morse_store_rec {
+	uint16_t magic;
+	uint8_t chan;
+	uint8_t reserved;
+	uint32_t nbits;
+};
+
+#define MORSE_STORE_HDR_SIZE ROUND_UP(sizeof(struct morse_store_rec), MORSE_STORE_ALIGN)
+
+BUILD_ASSERT(MORSE_STORE_MAX_BYTES % MORSE_STORE_ALIGN == 0, "morse_store_add() pads the bits in place");
+
+struct morse_store {
+	const struct flash_area* fa;
+	const uint8_t* base;     // the partition, memory-mapped
+	size_t loaded_end;       // records before this offset are played
+	size_t end;              // first free byte (after anything written, torn records too)
+	uint32_t count;          // records loaded
+	bool damaged;            // written flash after the records: only an erase can be added
+};
+
+/* Where one channel is in its list of records (fetch() context). */
+struct morse_store_cursor {
+	const struct morse_store* store;
+	const struct morse_bits_reader* rd;  // the reader it feeds
+	uint8_t chan;
+	size_t after_first;      // offset right after the channel's first record
+	size_t next;             // where to look for the one after the current
+};
+
+static struct morse_store* shell_store;  // the store "morse store" works on
+
+/* Bytes a record takes, header and padding included. */
+static inline size_t morse_store_rec_size(const struct morse_store_rec* rec)
+{
+	return MORSE_STORE_HDR_SIZE + ROUND_UP(MORSE_BITS_BYTES((size_t)rec->nbits), MORSE_STORE_ALIGN);
+}
+
+/* The bits of a record, right after its header. */
+static inline const uint8_t* morse_store_rec_bits(const struct morse_store_rec* rec)
+{
+	return (const uint8_t*)rec + MORSE_STORE_HDR_SIZE;
+}
+
+/*
+ * Record at offset off, or NULL if there is none (end of the log). A header
+ * cut short has 0xFF where it stopped: a reserved byte that is not 0, or a
+ * length that runs past the end.
+ */
+static const struct morse_store_rec* morse_store_rec_at(const struct morse_store* s, size_t off, size_t limit)
+{
+	const struct morse_store_rec* rec = (const struct morse_store_rec*)(s->base + off);
+
+	if (off + MORSE_STORE_HDR_SIZE > limit || rec->magic != MORSE_STORE_MAGIC || rec->reserved != 0U ||
+	    rec->nbits > limit * 8U || off + morse_store_rec_size(rec) > limit) {
+		return NULL;
+	}
+	return rec;
+}
+
+/* First record of chan at or after off, among the loaded ones. Returns its offset or SIZE_MAX. */
+static size_t morse_store_find(const struct morse_store* s, uint8_t chan, size_t off)
+{
+	const struct morse_store_rec* rec;
+
+	while ((rec = morse_store_rec_at(s, off, s->loaded_end)) != NULL) {
+		if (rec->chan == chan) {
+			return off;
+		}
+		off += morse_store_rec_size(rec);
+	}
+	return SIZE_MAX;
+}
+
+/* morse_bits_reader fetch(): the channel's next record, or NULL (and back to the first) at the end. */
+static const uint8_t* morse_store_fetch(void* ctx, size_t* num_bits)
+{
+	struct morse_store_cursor* cur = ctx;
+
+	/* Reader is on the first record again (rewound after the last one): start over. */
+	if (cur->rd->chunk == cur->rd->first) {
+		cur->next = cur->after_first;
+	}
+
+	size_t off = morse_store_find(cur->store, cur->chan, cur->next);
+	if (off == SIZE_MAX) {
+		return NULL;  // that was the last one
+	}
+
+	const struct morse_store_rec* rec = morse_store_rec_at(cur->store, off, cur->store->loaded_end);
+
+	cur->next = off + morse_store_rec_size(rec);
+	*num_bits = rec->nbits;
+	return morse_store_rec_bits(rec);
+}
+
+/* Has the flash at off..off+len never been written since the last erase? */
+static bool morse_store_is_erased(const struct morse_store* s, size_t off, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (s->base[off + i] != 0xFFU) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* First aligned offset after the last written byte of the partition. */
+static size_t morse_store_written_end(const struct morse_store* s)
+{
+	size_t len = s->fa->fa_size;
+
+	while (len > 0 && s->base[len - 1] == 0xFFU) {
+		len--;
+	}
+	return ROUND_UP(len, MORSE_STORE_ALIGN);
+}
+
+int morse_store_init(struct morse_store* s) {
+	// Open the "geoffcha,morse-store" partition, map it and find its records.
+	// Carries out an erase that "morse store erase" asked for, also one made
+	// after a write that was cut short.
+	// Returns: 0, or a negative error code from the flash map.
+
+	int ret = flash_area_open(DT_FIXED_PARTITION_ID(MORSE_STORE_NODE), &s->fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+#if DT_HAS_COMPAT_STATUS_OKAY(zephyr_sim_flash)
+	size_t sim_size;
+	s->base = (const uint8_t*)flash_simulator_get_memory(flash_area_get_device(s->fa), &sim_size) +
+	          s->fa->fa_off;
+#else
+	s->base = (const uint8_t*)DT_REG_ADDR(DT_MTD_FROM_FIXED_PARTITION(MORSE_STORE_NODE)) + s->fa->fa_off;
+#endif
+
+	/* Walk the headers once; the first one that is not a record ends the log. */
+	const struct morse_store_rec* rec;
+	bool erase = false;
+	size_t off = 0;
+
+	s->count = 0;
+	while ((rec = morse_store_rec_at(s, off, s->fa->fa_size)) != NULL) {
+		erase = erase || (rec->chan == MORSE_STORE_CHAN_ERASE);
+		off += morse_store_rec_size(rec);
+		s->count++;
+	}
+	s->loaded_end = off;
+	s->end = off;
+	s->damaged = !morse_store_is_erased(s, off, s->fa->fa_size - off);
+
+	/* A write was cut short: the erase record, if any, is the last thing written. */
+	if (s->damaged) {
+		s->end = morse_store_written_end(s);
+		rec = (s->end >= off + MORSE_STORE_HDR_SIZE) ?
+		      morse_store_rec_at(s, s->end - MORSE_STORE_HDR_SIZE, s->end) : NULL;
+		erase = erase || (rec != NULL && rec->chan == MORSE_STORE_CHAN_ERASE && rec->nbits == 0U);
+		erase = erase || (s->end + MORSE_STORE_HDR_SIZE > s->fa->fa_size);  // no room to ask for one
+	}
+
+	if (erase) {
+		ret = flash_area_erase(s->fa, 0, s->fa->fa_size);
+		if (ret < 0) {
+			return ret;
+		}
+		s->loaded_end = 0;
+		s->end = 0;
+		s->count = 0;
+		s->damaged = false;
+	}
+	shell_store = s;
+	return 0;
+}
+
+static int morse_store_append(struct morse_store* s, uint8_t chan, const uint8_t* bits, size_t nbits)
+{
+	struct morse_store_rec rec = {
+		.magic = MORSE_STORE_MAGIC, .chan = chan, .reserved = 0, .nbits = (uint32_t)nbits,
+	};
+	uint8_t hdr[MORSE_STORE_HDR_SIZE];
+	size_t data_len = ROUND_UP(MORSE_BITS_BYTES(nbits), MORSE_STORE_ALIGN);
+	size_t keep = (chan == MORSE_STORE_CHAN_ERASE) ? 0U : MORSE_STORE_HDR_SIZE;  // room to erase a full store
+	size_t off = s->end;
+
+	if (off + MORSE_STORE_HDR_SIZE + data_len + keep > s->fa->fa_size) {
+		return -ENOSPC;
+	}
+	if (!morse_store_is_erased(s, off, MORSE_STORE_HDR_SIZE + data_len)) {
+		return -EIO;  // left over from an interrupted write
+	}
+	memset(hdr, 0xFF, sizeof(hdr));
+	memcpy(hdr, &rec, sizeof(rec));
+
+	/* Bits first, header last: until the header is there, the record does not exist. */
+	int ret = (data_len > 0) ? flash_area_write(s->fa, off + MORSE_STORE_HDR_SIZE, bits, data_len) : 0;
+	if (ret == 0) {
+		ret = flash_area_write(s->fa, off, hdr, sizeof(hdr));
+	}
+	if (ret < 0) {
+		/* Whatever got written stays: the next record goes after it. */
+		s->damaged = true;
+		s->end = off + MORSE_STORE_HDR_SIZE + data_len;
+		return ret;
+	}
+	s->end = off + MORSE_STORE_HDR_SIZE + data_len;
+	return 0;
+}
+
+int morse_store_add(struct morse_store* s, uint8_t chan, const char* text) {
+	// Encode text and append it to chan's messages (played from the next boot on).
+	// Returns: 0, -EINVAL/-ENOMEM if text can't be encoded (see morse_bits_encode()),
+	//          -ENOSPC if the partition is full (room for an erase is always
+	//          kept), -EIO after an interrupted write (erase the store), or a
+	//          flash error code.
+
+	static uint8_t bits[MORSE_STORE_MAX_BYTES];  // multiple of MORSE_STORE_ALIGN, zero padded
+
+	if (s->damaged) {
+		return -EIO;  // records after the damage would never be found
+	}
+	int nbits = morse_bits_encode(text, bits, sizeof(bits));
+	if (nbits < 0) {
+		return nbits;
+	}
+	return morse_store_append(s, chan, bits, (size_t)nbits);
+}
+
+int morse_store_erase(struct morse_store* s) {
+	// Ask for an empty store at the next boot (erasing now would pull the
+	// flash out from under the players). Works on a damaged store too.
+	// Returns: 0, -ENOSPC if the partition is full, or a flash error code.
+	return morse_store_append(s, MORSE_STORE_CHAN_ERASE, NULL, 0);
+}
+
+bool morse_store_reader(const struct morse_store* s, struct morse_store_cursor* cur, uint8_t chan,
+                        struct morse_bits_reader* rd) {
+	// Set up rd to play all of chan's records in a loop, straight from flash.
+	// Returns: false if the store has nothing for chan (rd is untouched).
+
+	size_t first = morse_store_find(s, chan, 0);
+	if (first == SIZE_MAX) {
+		return false;
+	}
+
+	const struct morse_store_rec* rec = morse_store_rec_at(s, first, s->loaded_end);
+
+	cur->store = s;
+	cur->rd = rd;
+	cur->chan = chan;
+	cur->after_first = first + morse_store_rec_size(rec);
+	cur->next = cur->after_first;
+	morse_bits_reader_init(rd, morse_store_rec_bits(rec), rec->nbits, morse_store_fetch, cur);
+	return true;
+}
+
+/* --- Shell: morse store [add <chan> <text> | erase] --- */
+
+static int cmd_store_list(const struct shell* sh, size_t argc, char** argv)
+{
+	uint32_t recs[16] = { 0 };
+	uint32_t units[16] = { 0 };
+	const struct morse_store_rec* rec;
+	size_t off = 0;
+
+	if (shell_store == NULL) {
+		shell_error(sh, "no message store");
+		return -ENODEV;
+	}
+	while ((rec = morse_store_rec_at(shell_store, off, shell_store->loaded_end)) != NULL) {
+		if (rec->chan < ARRAY_SIZE(recs)) {
+			recs[rec->chan]++;
+			units[rec->chan] += rec->nbits;
+		}
+		off += morse_store_rec_size(rec);
+	}
+	for (size_t chan = 0; chan < ARRAY_SIZE(recs); chan++) {
+		if (recs[chan] != 0U) {
+			shell_print(sh, "chan %u: %u messages, %u T", (unsigned)chan, recs[chan], units[chan]);
+		}
+	}
+	shell_print(sh, "%u records loaded, %u bytes used (%u since boot), %u free",
+	            shell_store->count, (uint32_t)shell_store->end,
+	            (uint32_t)(shell_store->end - shell_store->loaded_end),
+	            (uint32_t)(shell_store->fa->fa_size - shell_store->end));
+	if (shell_store->damaged) {
+		shell_warn(sh, "a write was cut short: \"morse store erase\" before adding");
+	}
+	return 0;
+}
+
+static int cmd_store_add(const struct shell* sh, size_t argc, char** argv)
+{
+	char* end;
+	unsigned long chan = strtoul(argv[1], &end, 10);
+
+	if (shell_store == NULL) {
+		shell_error(sh, "no message store");
+		return -ENODEV;
+	}
+	if (*end != '\0' || chan >= MORSE_STORE_CHAN_ERASE) {
+		shell_error(sh, "bad channel \"%s\"", argv[1]);
+		return -EINVAL;
+	}
+	int ret = morse_store_add(shell_store, (uint8_t)chan, argv[2]);
+	if (ret < 0) {
+		shell_error(sh, "can't store \"%s\" (%d)", argv[2], ret);
+		return ret;
+	}
+	shell_print(sh, "stored, plays from the next boot");
+	return 0;
+}
+
+static int cmd_store_erase(const struct shell* sh, size_t argc, char** argv)
+{
+	if (shell_store == NULL) {
+		shell_error(sh, "no message store");
+		return -ENODEV;
+	}
+	int ret = morse_store_erase(shell_store);
+	if (ret < 0) {
+		shell_error(sh, "erase failed (%d)", ret);
+		return ret;
+	}
+	shell_print(sh, "store will be empty after the next boot");
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_store,
+	SHELL_CMD_ARG(add, NULL, "Store a message: add <chan> <text>", cmd_store_add, 3, 0),
+	SHELL_CMD_ARG(erase, NULL, "Empty the store at the next boot", cmd_store_erase, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((morse), store, &sub_store, "Flash message store", cmd_store_list, 1, 0);
+
+#endif /* MORSE_STORE_H */
@@ -0,0 +1,258 @@
+#ifndef MORSE_STRIPE_H
+#define MORSE_STRIPE_H
+
+#include <stdint.h>               // uint8_t
+#include <stdbool.h>              // bool
+#include <string.h>               // memset()
+#include <errno.h>                // EINVAL, ENOMEM
+#include <zephyr/drivers/gpio.h>  // gpio_pin_get_dt()
+#include <zephyr/sys/util.h>      // MAX()
+#include <morse.h>                // morse_lookup(), morse_char()
+#include <morse_bits.h>           // morse_bits_put(): same 1-bit-per-unit format
+
+/*
+ * Striping: ONE message sent over N LEDs at once.
+ *
+ * The letters are dealt out like cards: letter 0 to LED 0, letter 1 to LED 1,
+ * ..., letter N to LED 0 again. The N letters sent together form a "slot".
+ * Every LED runs on the same clock (same T, same start), so a slot lasts as
+ * long as its longest letter, and all LEDs are off for the 3T letter gap
+ * between slots:
+ *
+ *   "paris cq" on 4 LEDs       slot 0      gap  slot 1      gap
+ *   LED 0:                     P .--.      ...  S ...       ...  ...
+ *   LED 1:                     A .-        ...  (space)     ...
+ *   LED 2:                     R .-.       ...  C -.-.      ...
+ *   LED 3:                     I ..        ...  Q --.-      .......
+ *
+ * A word space is a "letter" too: that LED just stays dark for the slot.
+ * The message ends with a 7T word gap on every LED, so it loops like any
+ * other bitstream. With N = 1 this is exactly morse_bits_encode().
+ *
+ * The receiver samples all N lines in the middle of every unit (it knows T
+ * and the clock is shared). While any line is ON it collects dots and dashes
+ * per line; when ALL lines have been off for 3T the slot is complete and its
+ * letters come out in line order, a dark line as ' '. 7T of darkness is the
+ * end of the message: the letters up to the last lit line, then ' '.
+ *
+ * Leading, trailing and repeated spaces are dropped, so there is never a
+ * slot with nothing in it (except for N = 1, where a space just stretches
+ * the gap before the next letter to 7T, as in normal Morse).
+ */
+
+#define MORSE_STRIPE_MAX_CHANS 32
+
+/* Walks the text letter by letter; a space between two words comes out as MORSE_CODE_SPACE. */
+struct morse_stripe_text {
+	const char* p;
+	uint8_t held;   // letter found after a space, returned next time
+	bool started;   // a letter was returned already (no leading space)
+};
+
+/* Next slot entry of the text: a letter code, MORSE_CODE_SPACE, or MORSE_CODE_NONE at the end. */
+static uint8_t morse_stripe_next(struct morse_stripe_text* t)
+{
+	bool space = false;
+
+	if (t->held != MORSE_CODE_NONE) {
+		uint8_t code = t->held;
+		t->held = MORSE_CODE_NONE;
+		return code;
+	}
+	for (; *t->p != '\0'; t->p++) {
+		uint8_t code = morse_lookup(*t->p);
+
+		if (code == MORSE_CODE_SPACE) {
+			space = true;
+		} else if (code != MORSE_CODE_NONE) {
+			t->p++;
+			if (space && t->started) {
+				t->held = code;  // one space for any run of them
+				return MORSE_CODE_SPACE;
+			}
+			t->started = true;
+			return code;
+		}
+	}
+	return MORSE_CODE_NONE;  // trailing spaces are dropped
+}
+
+/* Units one letter takes, without the gap after it (0 for a space). */
+static uint32_t morse_stripe_letter_units(uint8_t code)
+{
+	uint32_t units = 0;
+
+	for (; code > 1U; code >>= 1) {
+		units += ((code & 1U) ? MORSE_DASH_UNITS : MORSE_DOT_UNITS) + MORSE_SYMBOL_GAP_UNITS;
+	}
+	return (units != 0U) ? units - MORSE_SYMBOL_GAP_UNITS : 0U;
+}
+
+int morse_stripe_encode(const char* text, size_t num_chans, uint8_t* const bufs[], size_t buf_len) {
+	// Deals text out over num_chans bitstreams (morse_bits.h format), one per LED.
+	// Every buffer is buf_len bytes and all of them come out the same length.
+	// Returns: number of bits in EACH buffer, -EINVAL if text has nothing to send
+	//          or num_chans is 0 / too big, -ENOMEM if a buffer is too small.
+
+	struct morse_stripe_text t = { .p = text };
+	uint8_t codes[MORSE_STRIPE_MAX_CHANS];
+	size_t nbits = 0;        // where the current slot starts, same on every line
+	uint32_t gap_units = 0;  // all-off time owed before the next slot
+	int ret;
+
+	if (num_chans == 0 || num_chans > MORSE_STRIPE_MAX_CHANS) {
+		return -EINVAL;
+	}
+	for (size_t c = 0; c < num_chans; c++) {
+		memset(bufs[c], 0, buf_len);  // OFF is 0, so gaps are just skipped over
+	}
+
+	uint8_t code = morse_stripe_next(&t);
+	if (code == MORSE_CODE_NONE) {
+		return -EINVAL;
+	}
+
+	while (code != MORSE_CODE_NONE) {
+		/* Deal the next num_chans entries; a short last slot leaves lines dark. */
+		uint32_t slot_units = 0;
+		for (size_t c = 0; c < num_chans; c++) {
+			codes[c] = code;
+			slot_units = MAX(slot_units, morse_stripe_letter_units(code));
+			if (code != MORSE_CODE_NONE) {
+				code = morse_stripe_next(&t);
+			}
+		}
+		if (slot_units == 0U) {
+			gap_units = MORSE_WORD_GAP_UNITS;  // only a space (N = 1): a word gap instead
+			continue;
+		}
+
+		nbits += gap_units;
+		for (size_t c = 0; c < num_chans; c++) {
+			size_t pos = nbits;
+			ret = 0;
+			for (uint8_t elems = codes[c]; ret == 0 && elems > 1U; elems >>= 1) {
+				ret = morse_bits_put(bufs[c], buf_len, &pos, true, (elems & 1U) ? MORSE_DASH_UNITS : MORSE_DOT_UNITS);
+				pos += MORSE_SYMBOL_GAP_UNITS;
+			}
+			if (ret < 0) {
+				return ret;
+			}
+		}
+		nbits += slot_units;
+		gap_units = MORSE_LETTER_GAP_UNITS;
+	}
+
+	nbits += MORSE_WORD_GAP_UNITS;
+	if (nbits > buf_len * 8U) {
+		return -ENOMEM;
+	}
+	return (int)nbits;
+}
+
+/* --- Receiver --- */
+
+struct morse_stripe_rx;
+typedef void (*morse_stripe_char_cb)(struct morse_stripe_rx* rx, char c);
+
+struct morse_stripe_rx {
+	const struct gpio_dt_spec* pins;  // one input per LED, in the sender's order
+	size_t num_chans;
+	morse_stripe_char_cb on_char;     // gets every decoded character
+	uint32_t quiet;                   // units with ALL lines off, up to a word gap
+	bool lit;                         // some line was on since the last slot was delivered
+	uint8_t on_units[MORSE_STRIPE_MAX_CHANS];   // length of the mark in progress, per line
+	uint8_t elems[MORSE_STRIPE_MAX_CHANS];      // letter so far (bit 0 = first, 1 = dash)
+	uint8_t num_elems[MORSE_STRIPE_MAX_CHANS];
+};
+
+/* A slot is complete: its letters in line order (a dark line is a space); at the end only up to the last lit line. */
+static void morse_stripe_rx_slot(struct morse_stripe_rx* rx, bool end)
+{
+	size_t last = rx->num_chans;
+
+	if (!rx->lit) {
+		return;
+	}
+	if (end) {
+		while (rx->num_elems[last - 1U] == 0U) {
+			last--;  // lit is set, so some line has elements
+		}
+	}
+	for (size_t c = 0; c < last; c++) {
+		uint8_t n = rx->num_elems[c];
+		char ch = ' ';
+
+		if (n != 0U) {
+			ch = (n <= MORSE_MAX_ELEMENTS) ? morse_char(rx->elems[c] | (uint8_t)(1U << n)) : 0;
+			ch = (ch != 0) ? ch : '?';
+		}
+		rx->on_char(rx, ch);
+	}
+	if (end) {
+		rx->on_char(rx, ' ');
+	}
+	memset(rx->elems, 0, sizeof(rx->elems));
+	memset(rx->num_elems, 0, sizeof(rx->num_elems));
+	rx->lit = false;
+}
+
+int morse_stripe_rx_init(struct morse_stripe_rx* rx, const struct gpio_dt_spec* pins, size_t num_chans,
+                         morse_stripe_char_cb on_char) {
+	// Receive a striped message on num_chans input pins (configured here as inputs).
+	// Returns: 0 on success, -EINVAL for no/too many lines, -ENODEV if a GPIO
+	//          is not ready, or a GPIO error code.
+
+	if (num_chans == 0 || num_chans > MORSE_STRIPE_MAX_CHANS) {
+		return -EINVAL;
+	}
+	for (size_t c = 0; c < num_chans; c++) {
+		if (!gpio_is_ready_dt(&pins[c])) {
+			return -ENODEV;
+		}
+		int ret = gpio_pin_configure_dt(&pins[c], GPIO_INPUT);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	memset(rx, 0, sizeof(*rx));
+	rx->pins = pins;
+	rx->num_chans = num_chans;
+	rx->on_char = on_char;
+	rx->quiet = MORSE_WORD_GAP_UNITS;  // idle: the first mark does not end a slot
+	return 0;
+}
+
+void morse_stripe_rx_sample(struct morse_stripe_rx* rx) {
+	// Call once per unit T, in the middle of the unit (e.g. from a k_timer).
+	// Decoded characters (upper case) go to on_char from here.
+
+	bool any = false;
+
+	for (size_t c = 0; c < rx->num_chans; c++) {
+		if (gpio_pin_get_dt(&rx->pins[c]) > 0) {
+			rx->on_units[c] += (rx->on_units[c] < UINT8_MAX) ? 1U : 0U;
+			any = true;
+		} else if (rx->on_units[c] != 0U) {
+			/* Mark over: 1 unit = dot, 3 = dash. */
+			if (rx->num_elems[c] < 8U) {
+				rx->elems[c] |= (uint8_t)((rx->on_units[c] >= 2U) << rx->num_elems[c]);
+			}
+			rx->num_elems[c] += (rx->num_elems[c] < UINT8_MAX) ? 1U : 0U;
+			rx->on_units[c] = 0;
+			rx->lit = true;
+		}
+	}
+
+	if (any) {
+		if (rx->quiet >= MORSE_LETTER_GAP_UNITS && rx->quiet < MORSE_WORD_GAP_UNITS) {
+			morse_stripe_rx_slot(rx, false);  // letter gap: next slot starts
+		}
+		rx->quiet = 0;
+	} else if (rx->quiet < MORSE_WORD_GAP_UNITS && ++rx->quiet == MORSE_WORD_GAP_UNITS) {
+		morse_stripe_rx_slot(rx, true);  // word gap: end of the message (or word, N = 1)
+	}
+}
+
+#endif /* MORSE_STRIPE_H */
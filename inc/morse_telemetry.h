@@ -0,0 +1,203 @@
+#ifndef MORSE_TELEMETRY_H
+#define MORSE_TELEMETRY_H
+
+#include <zephyr/kernel.h>        // k_timer, k_work_q
+#include <zephyr/drivers/i2c.h>   // i2c_transfer_cb(), i2c_transfer_dt()
+#include <zephyr/sys/atomic.h>    // atomic_cas()
+#include <zephyr/sys/byteorder.h> // sys_get_le16()
+#include <morse_queue.h>          // morse_queue_push()
+
+/*
+ * Temperature telemetry: STTS22H -> text -> Morse on one LED.
+ *
+ *   k_timer (every period_ms)
+ *     -> work item on a low-priority work queue
+ *        -> I2C read of the temperature registers
+ *           asynchronous (i2c_transfer_cb) when the I2C driver supports it,
+ *           otherwise a normal blocking read, but in the work queue's own
+ *           thread, never in an LED thread
+ *     -> "23.5c" (no snprintf)
+ *     -> morse_queue_push() + wake the consumer, like a "morse set" command
+ *
+ * The LED keeps sending the last reading; a new one replaces it at the next
+ * word gap (morse_slot.h), so a slow or failing sensor can never disturb LED
+ * timing: at worst the reading gets old.
+ *
+ * STTS22H: 16-bit two's complement temperature in 0.01 degC at 0x06/0x07,
+ * continuous conversion when CTRL.FREERUN is set.
+ */
+
+#define STTS22H_WHOAMI       0x01
+#define STTS22H_WHOAMI_VAL   0xA0
+#define STTS22H_CTRL         0x04
+#define STTS22H_TEMP_L_OUT   0x06
+
+#define STTS22H_CTRL_FREERUN     BIT(2)
+#define STTS22H_CTRL_IF_ADD_INC  BIT(3)  // multi-byte reads walk the registers
+
+#define TELEMETRY_STACK_SIZE 1024
+
+struct morse_telemetry {
+	const struct i2c_dt_spec* sensor;
+	struct morse_queue* q;         // where readings go (as text)
+	struct k_sem* wake;            // given after every reading
+	uint8_t chan;                  // LED that sends them
+
+	struct k_timer timer;          // sampling schedule
+	struct k_work work;            // one sample
+	atomic_t busy;                 // a transfer is in flight, skip this sample
+
+	/* The transfer itself (must stay valid until it completes). */
+	uint8_t reg;
+	uint8_t raw[2];
+	struct i2c_msg msgs[2];
+
+	uint32_t samples;              // readings sent to the LED
+	uint32_t errors;               // failed transfers
+	int16_t last_centi;            // last reading, 0.01 degC
+};
+
+K_THREAD_STACK_DEFINE(telemetry_stack, TELEMETRY_STACK_SIZE);
+static struct k_work_q telemetry_wq;
+
+size_t morse_telemetry_format(int32_t centi, char* out) {
+	// Write a temperature in 0.01 degC as text, one decimal: 2346 -> "23.5c".
+	// Halves round away from zero. out needs room for 14 chars (INT32_MIN is
+	// "-21474836.5c"). No printf: just divide and pick digits.
+	// Returns: length of the text.
+
+	char digits[10];
+	size_t num_digits = 0;
+	size_t len = 0;
+	uint32_t tenths;
+
+	tenths = (((centi < 0) ? 0U - (uint32_t)centi : (uint32_t)centi) + 5U) / 10U;  // round to 0.1 (INT32_MIN too)
+	if (centi < 0 && tenths != 0U) {
+		out[len++] = '-';  // but no "-0.0"
+	}
+
+	/* Whole degrees, lowest digit first, then copy them out in the right order. */
+	uint32_t whole = tenths / 10U;
+	do {
+		digits[num_digits++] = (char)('0' + whole % 10U);
+		whole /= 10U;
+	} while (whole != 0U);
+	while (num_digits > 0) {
+		out[len++] = digits[--num_digits];
+	}
+
+	out[len++] = '.';
+	out[len++] = (char)('0' + tenths % 10U);
+	out[len++] = 'c';
+	out[len] = '\0';
+	return len;
+}
+
+/* A transfer finished (any context, also the I2C interrupt): hand the reading on. */
+static void morse_telemetry_done(struct morse_telemetry* t, int result)
+{
+	struct morse_update upd;
+
+	if (result < 0) {
+		t->errors++;
+		atomic_set(&t->busy, 0);
+		return;
+	}
+
+	t->last_centi = (int16_t)sys_get_le16(t->raw);
+	upd.chan = t->chan;
+	morse_telemetry_format(t->last_centi, upd.text);
+	if (morse_queue_push(t->q, &upd, 1) == 0) {
+		t->samples++;
+		k_sem_give(t->wake);
+	}
+	atomic_set(&t->busy, 0);
+}
+
+#ifdef CONFIG_I2C_CALLBACK
+static void morse_telemetry_i2c_cb(const struct device* dev, int result, void* data)
+{
+	ARG_UNUSED(dev);
+	morse_telemetry_done(data, result);
+}
+#endif
+
+/* Work item: start one read. */
+static void morse_telemetry_sample(struct k_work* work)
+{
+	struct morse_telemetry* t = CONTAINER_OF(work, struct morse_telemetry, work);
+
+	if (!atomic_cas(&t->busy, 0, 1)) {
+		return;  // the last read has not finished yet, skip this one
+	}
+
+	t->reg = STTS22H_TEMP_L_OUT;
+	t->msgs[0].buf = &t->reg;
+	t->msgs[0].len = 1;
+	t->msgs[0].flags = I2C_MSG_WRITE;
+	t->msgs[1].buf = t->raw;
+	t->msgs[1].len = sizeof(t->raw);
+	t->msgs[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+
+#ifdef CONFIG_I2C_CALLBACK
+	int ret = i2c_transfer_cb(t->sensor->bus, t->msgs, 2, t->sensor->addr, morse_telemetry_i2c_cb, t);
+	if (ret != -ENOSYS) {
+		if (ret < 0) {
+			morse_telemetry_done(t, ret);
+		}
+		return;  // morse_telemetry_i2c_cb() finishes it
+	}
+	/* this I2C driver has no async API: fall back to a blocking read, right here */
+#endif
+	morse_telemetry_done(t, i2c_transfer_dt(t->sensor, t->msgs, 2));
+}
+
+static void morse_telemetry_tick(struct k_timer* timer)
+{
+	struct morse_telemetry* t = CONTAINER_OF(timer, struct morse_telemetry, timer);
+
+	k_work_submit_to_queue(&telemetry_wq, &t->work);
+}
+
+int morse_telemetry_start(struct morse_telemetry* t, const struct i2c_dt_spec* sensor,
+                          struct morse_queue* q, struct k_sem* wake, uint8_t chan, uint32_t period_ms) {
+	// Check the STTS22H, start continuous conversion and read it every period_ms.
+	// Readings go into q as text for LED chan; wake is given after each one.
+	// Returns: 0, -ENODEV if the bus is not ready or the chip is not an STTS22H,
+	//          or an I2C error code.
+
+	uint8_t id;
+
+	if (!i2c_is_ready_dt(sensor)) {
+		return -ENODEV;
+	}
+	int ret = i2c_reg_read_byte_dt(sensor, STTS22H_WHOAMI, &id);
+	if (ret < 0) {
+		return ret;
+	}
+	if (id != STTS22H_WHOAMI_VAL) {
+		return -ENODEV;
+	}
+	ret = i2c_reg_write_byte_dt(sensor, STTS22H_CTRL, STTS22H_CTRL_FREERUN | STTS22H_CTRL_IF_ADD_INC);
+	if (ret < 0) {
+		return ret;
+	}
+
+	t->sensor = sensor;
+	t->q = q;
+	t->wake = wake;
+	t->chan = chan;
+	t->samples = 0;
+	t->errors = 0;
+	atomic_set(&t->busy, 0);
+
+	/* Lowest priority: a blocking I2C read here only ever waits on itself. */
+	k_work_queue_start(&telemetry_wq, telemetry_stack, K_THREAD_STACK_SIZEOF(telemetry_stack),
+	                   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+	k_work_init(&t->work, morse_telemetry_sample);
+	k_timer_init(&t->timer, morse_telemetry_tick, NULL);
+	k_timer_start(&t->timer, K_MSEC(100), K_MSEC(period_ms));  // first conversion is ready by then
+	return 0;
+}
+
+#endif /* MORSE_TELEMETRY_H */
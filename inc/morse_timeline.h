@@ -0,0 +1,77 @@
+#ifndef MORSE_TIMELINE_H
+#define MORSE_TIMELINE_H
+
+#include <stdint.h>
+#include <zephyr/sys/util_macro.h>  // FOR_EACH_IDX_FIXED_ARG, NUM_VA_ARGS_LESS_1
+#include <zephyr/toolchain.h>       // BUILD_ASSERT
+#include <morse.h>                  // MORSE_CHART_x, MORSE_*_UNITS
+
+/*
+ * Build-time Morse timelines.
+ *
+ * A timeline is the same ON/OFF list that morse_encode_units() makes at
+ * runtime, in units of T:
+ *   { ON, OFF, ON, OFF, ..., ON, OFF }
+ * but written out by the preprocessor, so it ends up as a const array in
+ * flash and the thread only has to replay it:
+ *
+ *   MORSE_TIMELINE_DEFINE(tl_geoff, G, E, O, F, F);
+ *   // -> static const uint8_t tl_geoff[] = { 3,1,3,1,1,3, 1,3, ... ,1,7 };
+ *
+ * Words are given as one chart name per argument (see MORSE_CHART_x in
+ * morse.h): A-Z, 0-9, PERIOD, SLASH, ... and prosigns such as AR or SK. The
+ * last OFF is the 7T word gap so the timeline loops back-to-back; every other
+ * letter ends in the 3T letter gap.
+ */
+
+#define Z_MORSE_UNITS_DIT MORSE_DOT_UNITS
+#define Z_MORSE_UNITS_DAH MORSE_DASH_UNITS
+
+/* A character's elements with 1T gaps between them, by element count. */
+#define Z_MORSE_TL_1(a) Z_MORSE_UNITS_##a
+#define Z_MORSE_TL_2(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_1(__VA_ARGS__)
+#define Z_MORSE_TL_3(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_2(__VA_ARGS__)
+#define Z_MORSE_TL_4(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_3(__VA_ARGS__)
+#define Z_MORSE_TL_5(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_4(__VA_ARGS__)
+#define Z_MORSE_TL_6(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_5(__VA_ARGS__)
+#define Z_MORSE_TL_7(a, ...) Z_MORSE_UNITS_##a, MORSE_SYMBOL_GAP_UNITS, Z_MORSE_TL_6(__VA_ARGS__)
+
+/* The same, added up. */
+#define Z_MORSE_TLU_1(a) Z_MORSE_UNITS_##a
+#define Z_MORSE_TLU_2(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_1(__VA_ARGS__))
+#define Z_MORSE_TLU_3(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_2(__VA_ARGS__))
+#define Z_MORSE_TLU_4(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_3(__VA_ARGS__))
+#define Z_MORSE_TLU_5(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_4(__VA_ARGS__))
+#define Z_MORSE_TLU_6(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_5(__VA_ARGS__))
+#define Z_MORSE_TLU_7(a, ...) (Z_MORSE_UNITS_##a + MORSE_SYMBOL_GAP_UNITS + Z_MORSE_TLU_6(__VA_ARGS__))
+
+/* One character: its elements with 1T gaps, then the gap after it. MORSE_TL(A, 3) -> 1, 1, 3, 3 */
+#define MORSE_TL(x, gap) Z_MORSE_CHART(Z_MORSE_TL_, x), (gap)
+
+/* ON+OFF units of one character, not counting the gap after it. */
+#define MORSE_TLU(x) Z_MORSE_CHART(Z_MORSE_TLU_, x)
+
+/* Gap after letter idx: 3T between letters, 7T after the last one. */
+#define Z_MORSE_TL_GAP(idx, last) \
+	(((idx) == (last)) ? MORSE_WORD_GAP_UNITS : MORSE_LETTER_GAP_UNITS)
+
+#define Z_MORSE_TL_LETTER(idx, x, last) MORSE_TL(x, Z_MORSE_TL_GAP(idx, last))
+#define Z_MORSE_TL_LETTER_UNITS(idx, x, last) (MORSE_TLU(x) + Z_MORSE_TL_GAP(idx, last))
+
+/* Initializer list for a word, e.g. { MORSE_TIMELINE(C, H, A) } */
+#define MORSE_TIMELINE(...) \
+	FOR_EACH_IDX_FIXED_ARG(Z_MORSE_TL_LETTER, (,), NUM_VA_ARGS_LESS_1(__VA_ARGS__), __VA_ARGS__)
+
+/* Total length of one repeat of the word in T, as a constant expression. */
+#define MORSE_TIMELINE_UNITS(...) \
+	(FOR_EACH_IDX_FIXED_ARG(Z_MORSE_TL_LETTER_UNITS, (+), NUM_VA_ARGS_LESS_1(__VA_ARGS__), __VA_ARGS__))
+
+/*
+ * Define a timeline array in flash (static const -> .rodata).
+ * The array always holds ON/OFF pairs, checked at compile time.
+ */
+#define MORSE_TIMELINE_DEFINE(name, ...)                                     \
+	static const uint8_t name[] = { MORSE_TIMELINE(__VA_ARGS__) };       \
+	BUILD_ASSERT((sizeof(name) % 2U) == 0U, #name " must be ON/OFF pairs")
+
+#endif /* MORSE_TIMELINE_H */
@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+#
+# Build every main_*.c variant for native_sim with the benchmark harness
+# (inc/morse_bench.h), run each one for the same time and collect the reports.
+#
+#   scripts/bench.sh [seconds] [variant.c ...]
+#
+# Output: bench_output.txt with the BENCH lines of every variant, plus the
+# ROM/RAM footprint (text / data / bss of the Zephyr image) of each build.
+#
+# Note: native_sim runs on simulated time, so code run time does not move the
+# clock. Jitter and drift here come from timer/tick rounding and the way each
+# variant sleeps; on real hardware build with -DMORSE_BENCH=ON and read the
+# same BENCH lines from the console.
+
+set -euo pipefail
+
+. "$(dirname "$0")/build_variant.sh"
+
+SECONDS_TO_RUN=${1:-60}
+shift || true
+VARIANTS=("$@")
+if [ ${#VARIANTS[@]} -eq 0 ]; then
+	VARIANTS=(src/main.c src/main_01_29_2026_threaded.c src/main_morse_Geoff.c
+	          src/main_morse_test.c src/main_morse_sched.c src/main_morse_dt.c)
+fi
+
+OUT=bench_output.txt
+: > "$OUT"
+
+for variant in "${VARIANTS[@]}"; do
+	name=$(basename "$variant" .c)
+	build=build/bench_$name
+
+	echo "=== $name" | tee -a "$OUT"
+	build_variant "$build" native_sim "$variant" -DMORSE_BENCH=ON -DMORSE_BENCH_SECONDS="$SECONDS_TO_RUN" || { echo "BENCH build failed, see $build.log" | tee -a "$OUT"; continue; }
+
+	# Footprint of the Zephyr part of the image (native_sim links it into zephyr.exe).
+	size -B "$build/zephyr/zephyr.elf" | awk 'NR == 2 { printf "BENCH footprint rom=%d ram=%d (text=%d data=%d bss=%d)\n", $1 + $2, $2 + $3, $1, $2, $3 }' | tee -a "$OUT"
+
+	# Run a little longer than the benchmark so the report gets printed, then stop.
+	"$build/zephyr/zephyr.exe" -no-rt -stop_at=$((SECONDS_TO_RUN + 1)) 2>&1 | grep '^BENCH' | tee -a "$OUT" || true
+done
+
+echo "Results in $OUT"
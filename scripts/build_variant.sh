@@ -0,0 +1,37 @@
+# Sourced by the scripts next to it, not run on its own:
+#
+#   . "$(dirname "$0")/build_variant.sh"
+#   build_variant <build dir> <board> <main_*.c> [-D... more CMake options]
+#   readme_results <name> <file>
+#
+# Sourcing it moves to the repository root and makes sure build/ exists.
+# build_variant builds one MORSE_MAIN variant from scratch into <build dir>,
+# with the whole build output in <build dir>.log, and returns west's status.
+# readme_results puts <file> into README.md between the lines
+# "<!-- <name> results -->" and "<!-- end <name> results -->", so a run's
+# numbers get committed with the README.
+
+cd "$(dirname "${BASH_SOURCE[0]}")/.."
+mkdir -p build
+
+build_variant() {
+	local build=$1 board=$2 main=$3
+	shift 3
+
+	west build -p -b "$board" -d "$build" . -- -DMORSE_MAIN="$main" "$@" > "$build.log" 2>&1
+}
+
+readme_results() {
+	local name=$1 file=$2
+
+	awk -v name="$name" -v file="$file" '
+		$0 == "<!-- end " name " results -->" { skip = 0 }
+		!skip { print }
+		$0 == "<!-- " name " results -->" {
+			print "```"
+			while ((getline line < file) > 0) print line
+			print "```"
+			skip = 1
+		}
+	' README.md > README.md.tmp && mv README.md.tmp README.md
+}
@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+#
+# LED edge jitter under CPU load: fixed-priority vs EDF scheduling.
+#
+#   scripts/edf_compare.sh [busy ms per 100 ms] [seconds]
+#
+# Builds src/main_morse_Geoff.c for native_sim with the benchmark harness and a
+# synthetic load thread at LED priority (inc/morse_load.h), once without and
+# once with -DMORSE_EDF=ON, and prints the BENCH jitter/drift lines of both.
+# Run with load 0 for the baseline.
+#
+# Output: edf_compare_output.txt with those lines, also copied into README.md
+# (section EDF scheduling under load) to be committed.
+
+set -euo pipefail
+
+. "$(dirname "$0")/build_variant.sh"
+
+LOAD_MS=${1:-30}
+SECONDS_TO_RUN=${2:-60}
+
+OUT=edf_compare_output.txt
+: > "$OUT"
+
+for edf in OFF ON; do
+	build=build/edf_$edf
+
+	echo "=== MORSE_EDF=$edf on native_sim, load $LOAD_MS ms / 100 ms, $SECONDS_TO_RUN s" | tee -a "$OUT"
+	build_variant "$build" native_sim src/main_morse_Geoff.c -DMORSE_EDF=$edf -DMORSE_LOAD_MS="$LOAD_MS" \
+		-DMORSE_BENCH=ON -DMORSE_BENCH_SECONDS="$SECONDS_TO_RUN" || { echo "build failed, see $build.log" | tee -a "$OUT"; continue; }
+
+	"$build/zephyr/zephyr.exe" -no-rt -stop_at=$((SECONDS_TO_RUN + 1)) 2>&1 \
+		| grep -E '^BENCH (jitter|drift)' | tee -a "$OUT" || true
+done
+readme_results edf_compare "$OUT"
+echo "results in $OUT and README.md"
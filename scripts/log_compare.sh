@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+#
+# LED edge jitter with logging on the timing path: immediate (formatted and
+# printed in the LED thread, like printk) vs deferred (arguments copied into a
+# buffer, printed later by the log thread).
+#
+#   scripts/log_compare.sh [seconds] [board]
+#
+# Output: log_compare_output.txt with the jitter and drift lines of both
+# modes, also copied into README.md (section Logging) to be committed.
+#
+# Builds src/main_morse_Geoff.c with the benchmark harness and
+# -DMORSE_LOG_LEVEL=4, so every LED logs a line after every word, right before
+# its next edge. Default board qemu_x86_64: unlike native_sim, time there
+# moves while the CPU works, so the cost of printing shows up as jitter.
+# QEMU does not slow its UART down to a real baud rate; on hardware with a
+# 115200 baud console the immediate numbers get much worse.
+
+set -euo pipefail
+
+. "$(dirname "$0")/build_variant.sh"
+
+SECONDS_TO_RUN=${1:-60}
+BOARD=${2:-qemu_x86_64}
+
+OUT=log_compare_output.txt
+: > "$OUT"
+
+for mode in immediate deferred; do
+	build=build/log_$mode
+	immediate=OFF
+	[ "$mode" = immediate ] && immediate=ON
+
+	echo "=== $mode logging on $BOARD, $SECONDS_TO_RUN s" | tee -a "$OUT"
+	build_variant "$build" "$BOARD" src/main_morse_Geoff.c -DMORSE_LOG_LEVEL=4 -DMORSE_LOG_IMMEDIATE=$immediate \
+		-DMORSE_BENCH=ON -DMORSE_BENCH_SECONDS="$SECONDS_TO_RUN" || { echo "build failed, see $build.log" | tee -a "$OUT"; continue; }
+
+	# The emulator does not exit by itself; stop it once the report is out.
+	timeout $((SECONDS_TO_RUN + 30)) west build -d "$build" -t run 2>&1 \
+		| sed '/^BENCH done/q' | grep -E '^BENCH (jitter|drift)' | tee -a "$OUT" || true
+done
+readme_results log_compare "$OUT"
+echo "results in $OUT and README.md"
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+#
+# LED edge jitter on two CPUs: LED threads floating vs pinned to their own CPU.
+#
+#   scripts/smp_compare.sh [busy ms per 100 ms] [seconds]
+#
+# Builds src/main_morse_Geoff.c for qemu_x86_64 with -DMORSE_SMP=ON, the
+# benchmark harness and a synthetic load thread at LED priority
+# (inc/morse_load.h), once with -DMORSE_SMP_PIN=OFF and once ON, runs each in
+# QEMU and prints the BENCH jitter, drift and per-CPU busy lines of both.
+# QEMU runs in real time, so every run takes [seconds] plus boot time.
+#
+# Output: smp_compare_output.txt with those lines, also copied into README.md
+# (section SMP and CPU pinning) to be committed.
+
+set -euo pipefail
+
+. "$(dirname "$0")/build_variant.sh"
+
+LOAD_MS=${1:-30}
+SECONDS_TO_RUN=${2:-60}
+
+OUT=smp_compare_output.txt
+: > "$OUT"
+
+for pin in OFF ON; do
+	build=build/smp_pin_$pin
+
+	echo "=== MORSE_SMP_PIN=$pin on qemu_x86_64, load $LOAD_MS ms / 100 ms, $SECONDS_TO_RUN s" | tee -a "$OUT"
+	build_variant "$build" qemu_x86_64 src/main_morse_Geoff.c -DMORSE_SMP=ON -DMORSE_SMP_PIN=$pin \
+		-DMORSE_LOAD_MS="$LOAD_MS" -DMORSE_BENCH=ON -DMORSE_BENCH_SECONDS="$SECONDS_TO_RUN" || { echo "build failed, see $build.log" | tee -a "$OUT"; continue; }
+
+	# QEMU does not exit by itself; stop it once the report is out.
+	timeout $((SECONDS_TO_RUN + 30)) west build -d "$build" -t run 2>&1 \
+		| sed '/^BENCH done/q' | grep -E '^BENCH (jitter|drift|cpu)' | tee -a "$OUT" || true
+done
+readme_results smp_compare "$OUT"
+echo "results in $OUT and README.md"
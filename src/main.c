@@ -1,10 +1,11 @@
 #include <stdio.h>                // standard C library (not strictly needed for blinking)
-#include <zephyr/kernel.h>        // Zephyr OS: threads + sleeping + printk
+#include <zephyr/kernel.h>        // Zephyr OS: threads + sleeping
+#include <zephyr/logging/log.h>   // LOG_INF(): deferred, printed later by the log thread
 #include <zephyr/drivers/gpio.h>  // GPIO driver API (LED pins are GPIO pins)
 #include <leds_funcs.h>           // our helper: setup_leds() configures LED pins
+#include <morse_stats.h>          // "morse stats": edges, lateness, thread CPU + stack per LED
 
-/* Time helpers: 1000 msec = 1 second */
-#define SLEEP_TIME_MS 1000         // 1000 milliseconds = 1 second
+LOG_MODULE_REGISTER(morse_blink, LOG_LEVEL_INF);  // log messages of this file say "morse_blink"
 
 /* Blink timing (milliseconds) */
 #define ON_TIME_MS 50              // keep LED ON for 50 ms
@@ -66,6 +67,20 @@ struct blink_args {
 /* One argument packet per LED/thread (global so it stays valid forever). */
 static struct blink_args blink_params[NUM_LEDS];
 
+/*
+ * Health counters per LED ("morse stats" in the shell). Here a "word" is one
+ * ON+OFF blink. k_msleep() never catches up when it wakes up late, so the
+ * lateness against the ideal schedule keeps growing: that is the drift.
+ */
+static struct morse_chan_stats blink_stats[NUM_LEDS];
+
+/* Count one edge and how late it is compared to when it should have happened. */
+static void count_edge(struct morse_chan_stats* cs, int64_t due)
+{
+	int64_t late = k_uptime_ticks() - due;  // ticks (negative = early)
+	morse_stats_edge(cs, (late > 0) ? k_ticks_to_us_floor32((uint32_t)late) : 0U);
+}
+
 /*
  * Thread entry function:
  * Zephyr threads always use the signature: void (*)(void*, void*, void*)
@@ -78,14 +93,21 @@ void blink_single_led(void* p1, void* p2, void* p3)
 
 	/* Convert the generic void* argument into our real type. */
 	const struct blink_args* args = (const struct blink_args*)p1; // "my instructions"
+	struct morse_chan_stats* cs = &blink_stats[args - blink_params]; // this LED's counters
+	int64_t due = k_uptime_ticks();             // when the next edge SHOULD happen
 
-	printk("Blink thread started for LED %p (on=%u ms, off=%u ms)\n",
+	LOG_INF("Blink thread started for LED %p (on=%u ms, off=%u ms)",
 	       args->led, (unsigned)args->on_time_ms, (unsigned)args->off_time_ms);
 	while (true) {                              // loop forever (this thread never ends)
+		count_edge(cs, due);                    // (health counters, see morse_stats.h)
 		gpio_pin_set_dt(args->led, 1);          // 1) turn THIS thread's LED ON
 		k_msleep(args->on_time_ms);             // 2) wait while it stays ON
+		due += k_ms_to_ticks_ceil64(args->on_time_ms);
+		count_edge(cs, due);
 		gpio_pin_set_dt(args->led, 0);          // 3) turn THIS thread's LED OFF
 		k_msleep(args->off_time_ms);            // 4) wait while it stays OFF
+		due += k_ms_to_ticks_ceil64(args->off_time_ms);
+		morse_stats_word(cs);                   // one whole blink done
 	}
 };
 
@@ -97,7 +119,9 @@ int main(void)
 		return 0;  // if setup fails, stop the program
 	}
 
-	printk("Starting threads...\n");
+	morse_stats_init(blink_stats, NUM_LEDS, thread_datas, NUM_LEDS);
+
+	LOG_INF("Starting threads...");
 	k_msleep(500);  // small delay before blinking begins
 
 	/* 2) Create one blinking thread per LED. */
@@ -127,8 +151,6 @@ int main(void)
 	 */
 
 	/* 3) main thread goes idle; blinking happens in the worker threads. */
-	while (1) {                      // main thread lives forever too
-		k_msleep(SLEEP_TIME_MS);     // it just sleeps; worker threads do the blinking
-	}
+	k_sleep(K_FOREVER);  // sleeps for good (no wakeups); worker threads do the blinking
 	return 0;
 }
@@ -1,8 +1,11 @@
 #include <stdio.h>
 #include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
 #include <zephyr/drivers/gpio.h>
 #include <leds_funcs.h>
 
+LOG_MODULE_REGISTER(morse_threaded, LOG_LEVEL_INF);
+
 /* 1000 msec = 1 sec */
 #define SLEEP_TIME_MS   1000
 #define ON_TIME_MS 50
@@ -41,9 +44,7 @@ void blink_single_led(const struct gpio_dt_spec* p_gds_led, size_t on_time, size
 	// const struct gpio_dt_spec* p_gds_led = (const struct gpio_dt_spec*)v_p_gds_led;
 	// size_t on_time = (size_t)v_p_on_time;
 	// size_t off_time = (size_t)v_p_off_time;
-	printk("p_gds_led %d, ", p_gds_led);
-	printk("on_time %d, ", on_time);
-	printk("off_time %d\n", off_time);
+	LOG_INF("p_gds_led %p, on_time %u, off_time %u", p_gds_led, (unsigned)on_time, (unsigned)off_time);
 	while (true) {
 		gpio_pin_set_dt(p_gds_led, 1);
 		k_msleep(on_time);
@@ -59,7 +60,7 @@ int main(void)
 		return 0;  // returning from the main() function halts the MCU
 	}
 
-	printk("Starting threads...\n");
+	LOG_INF("Starting threads...");
 	k_msleep(500);
 	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
 		thread_tids[idx] = k_thread_create(
@@ -70,8 +71,6 @@ int main(void)
 			MY_PRIORITY, 0, K_NO_WAIT);
 	}
 
-	while (1) {
-		k_msleep(1000);  // main thread now does nothing
-	}
+	k_sleep(K_FOREVER);  // main thread now does nothing (and never wakes up)
 	return 0;
 }
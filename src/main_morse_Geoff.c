@@ -1,8 +1,33 @@
 #include <stdio.h>
-#include <zephyr/kernel.h>        // Zephyr threads, sleep, printk, etc.
+#include <string.h>               // strcpy(), memcpy()
+#include <zephyr/kernel.h>        // Zephyr threads, sleep, etc.
+#include <zephyr/logging/log.h>   // LOG_INF(): deferred, formatted later by the log thread
 #include <zephyr/drivers/gpio.h>  // Zephyr GPIO types/functions for LEDs
-#include <zephyr/sys/util.h>      // ARG_UNUSED, ARRAY_SIZE
+#include <zephyr/sys/util.h>      // ARG_UNUSED, ARRAY_SIZE, DIV_ROUND_UP
 #include <leds_funcs.h>           // our helper functions: setup_leds(), set_leds()
+#include <morse_timeline.h>       // MORSE_TIMELINE_DEFINE(): words -> ON/OFF timelines at build time
+#include <morse_clock.h>          // morse_clock: absolute deadlines + lateness per edge
+#include <morse_bits.h>           // runtime messages are stored 1 bit per unit
+#include <morse_input.h>          // "morse set" shell command + UART protocol -> morse_queue
+#include <morse_slot.h>           // double-buffered message per LED, swapped between words
+#include <edge_trace.h>           // every edge -> trace ring ("morse trace dump")
+#include <morse_speed.h>          // WPM / Farnsworth -> microseconds
+#include <morse_stats.h>          // "morse stats": per-LED counters, thread CPU and stack
+#include <morse_smp.h>            // "morse cpu": LED threads on their own CPU, per-CPU load
+#ifdef MORSE_LOWPOWER
+#include <morse_power.h>          // "morse power": wakeups and idle time
+#else
+#include <morse_load.h>           // "morse load": synthetic CPU load at LED priority
+#endif
+
+/* STTS22H temperature sensor (x_nucleo_iks4a1.overlay, or emulated on native_sim). */
+#define STTS22H_NODE DT_NODELABEL(stts22h)
+#if DT_NODE_HAS_STATUS(STTS22H_NODE, okay)
+#include <morse_telemetry.h>      // temperature -> text -> LED, never blocking the LEDs
+#define USE_TELEMETRY 1
+#else
+#define USE_TELEMETRY 0
+#endif
 
 /*
  * Morse code timing uses a base unit "T".
@@ -10,8 +35,26 @@
  * - dash: ON 3T
  * - between dot/dash in same letter: OFF 1T
  * - between words (repeat gap):      OFF 7T
+ *
+ * T comes from the speed in words per minute: T = 1200 ms / WPM, so 8 WPM is
+ * the classic T = 150 ms. Each LED's speed (and Farnsworth spacing) can be
+ * changed at runtime with "morse speed <led> <wpm> [<overall wpm>]".
+ */
+#define START_WPM 8
+
+/*
+ * Units shorter than this use the high-speed clock (morse_clock.h): the last
+ * bit of every wait is spun on the cycle counter so sub-ms units keep their
+ * exact 1:3 ratios.
+ */
+#define PRECISE_BELOW_US 2000
+
+/*
+ * 1 = every edge is scheduled against an absolute deadline from the start of
+ *     the transmission, so timing errors never add up (see morse_clock.h).
+ * 0 = old relative k_msleep() timing (drifts a little every edge).
  */
-#define T_MS 150
+#define USE_ABS_DEADLINE 1
 
 /* How many LEDs we plan to use */
 #define NUM_LEDS 4
@@ -21,6 +64,33 @@
 #define MY_STACK_SIZE 1024
 #define MY_PRIORITY 5
 
+/*
+ * Synthetic CPU load at startup, in ms busy out of every 100 ms (0 = none,
+ * change it at runtime with "morse load"). Set with -DMORSE_LOAD_MS=30.
+ * Not in low-power mode, which is about doing as little as possible.
+ */
+#ifndef MORSE_LOAD_MS
+#define MORSE_LOAD_MS 0
+#endif
+
+/*
+ * Logging is deferred (prj.conf): a LOG_*() call only copies its arguments
+ * into the log buffer, the low-priority log thread formats and prints them
+ * (or, with -DMORSE_LOG_DICT=ON, the host does). -DMORSE_LOG_LEVEL=4 adds a
+ * debug line after every word of every LED.
+ */
+#ifndef MORSE_LOG_LEVEL
+#define MORSE_LOG_LEVEL LOG_LEVEL_INF
+#endif
+LOG_MODULE_REGISTER(morse_geoff, MORSE_LOG_LEVEL);
+
+/* How often main() prints the lateness report */
+#define REPORT_MS 10000
+
+/* With a temperature sensor, this LED sends the temperature (new reading every TELEMETRY_MS). */
+#define TELEMETRY_LED 3
+#define TELEMETRY_MS 10000
+
 /* Devicetree: get the board's LED nodes (led0, led1, led2, led3). */
 #define LED0_NODE DT_NODELABEL(led0)
 #define LED1_NODE DT_NODELABEL(led1)
@@ -52,143 +122,274 @@ const struct gpio_dt_spec* p_gds_leds[NUM_LEDS] = {
 };
 
 /* We are going to keep this SUPER simple:
- * - no structs
  * - no args->something
  * - just 4 thread functions (one per LED/word)
  */
 
-/* Helper: LED ON for ms milliseconds */
-static void led_on_for(const struct gpio_dt_spec* led, uint32_t ms)
+/* One clock per LED: keeps that LED's edges on schedule and measures lateness. */
+static struct morse_clock led_clocks[NUM_LEDS];
+
+/* Health counters per LED ("morse stats"), written only by that LED's thread. */
+static struct morse_chan_stats led_stats[NUM_LEDS];
+
+/* Helper: note this edge in the lateness stats, the counters and the edge trace */
+static inline void led_edge(const struct gpio_dt_spec* led, struct morse_clock* clk, uint8_t level)
+{
+	size_t idx = (size_t)(led - gds_leds);
+
+	morse_clock_edge(clk);
+	morse_stats_edge(&led_stats[idx], k_ticks_to_us_floor32((uint32_t)clk->last_late));
+	edge_trace_record((uint8_t)idx, level, k_ticks_to_cyc_floor32(clk->deadline));
+}
+
+/*
+ * Helper: wait until the next edge, us after this one.
+ * EDF mode (-DMORSE_EDF=ON): first tell the scheduler that edge is our
+ * deadline, so we win against same-priority work that is due later.
+ */
+static void led_wait(struct morse_clock* clk, uint32_t us)
+{
+#ifdef MORSE_EDF
+	uint32_t due_cyc = clk->start_cyc + (uint32_t)k_us_to_cyc_ceil64(clk->elapsed_us + us);
+	int32_t left = (int32_t)(due_cyc - k_cycle_get_32());
+
+	k_thread_deadline_set(k_current_get(), MAX(left, 0));
+#endif
+	morse_clock_wait_us(clk, us);
+}
+
+/* Helper: LED ON for us microseconds */
+static void led_on_for(const struct gpio_dt_spec* led, struct morse_clock* clk, uint32_t us)
 {
+	led_edge(led, clk, 1);
 	gpio_pin_set_dt(led, 1);
-	k_msleep(ms);
+	led_wait(clk, us);
 }
 
-/* Helper: LED OFF for ms milliseconds */
-static void led_off_for(const struct gpio_dt_spec* led, uint32_t ms)
+/* Helper: LED OFF for us microseconds */
+static void led_off_for(const struct gpio_dt_spec* led, struct morse_clock* clk, uint32_t us)
 {
+	led_edge(led, clk, 0);
 	gpio_pin_set_dt(led, 0);
-	k_msleep(ms);
+	led_wait(clk, us);
 }
 
 /*
- * Blink one letter pattern.
- * pattern is a string like ".-.." or "--."
+ * Speed of each LED. The shell writes the wanted speed into led_speed_req
+ * (WPM and Farnsworth WPM packed in one atomic word); the LED thread picks it
+ * up at its next word gap and keeps the worked-out timing in led_speed.
  */
-static void blink_pattern(const struct gpio_dt_spec* led, const char* pattern)
-{
-	for (size_t i = 0; pattern[i] != '\0'; i++) {
-		/* 1) Turn LED on for dot or dash */
-		if (pattern[i] == '.') {
-			led_on_for(led, 1U * T_MS);
-		} else if (pattern[i] == '-') {
-			led_on_for(led, 3U * T_MS);
-		}
+static atomic_t led_speed_req[NUM_LEDS];
+static uint32_t led_speed_now[NUM_LEDS];         // packed speed led_speed was made from
+static struct morse_speed led_speed[NUM_LEDS];   // LED thread only
 
-		/* 2) Gap between symbols inside the same letter (OFF 1T) */
-		if (pattern[i + 1] != '\0') {
-			led_off_for(led, 1U * T_MS);
-		}
-	}
-}
+/*
+ * The word each LED blinks, turned into an ON/OFF timeline (units of T) by the
+ * preprocessor and stored in flash (see morse_timeline.h). Nothing is parsed
+ * at runtime; the threads just replay these arrays.
+ */
+MORSE_TIMELINE_DEFINE(tl_geoff, G, E, O, F, F);
+MORSE_TIMELINE_DEFINE(tl_cha, C, H, A);
+MORSE_TIMELINE_DEFINE(tl_is, I, S);
+MORSE_TIMELINE_DEFINE(tl_dumb, D, U, M, B);
 
-/* Blink a whole word given as an array of letter-pattern strings. */
-static void blink_word(const struct gpio_dt_spec* led, const char* const letters[], size_t num_letters)
-{
-	for (size_t i = 0; i < num_letters; i++) {
-		blink_pattern(led, letters[i]);
+/* Length of one repeat of each word in T (word gap included). */
+BUILD_ASSERT(MORSE_TIMELINE_UNITS(G, E, O, F, F) == 58, "geoff should be 58T");
+BUILD_ASSERT(MORSE_TIMELINE_UNITS(C, H, A) == 36, "cha should be 36T");
+BUILD_ASSERT(MORSE_TIMELINE_UNITS(I, S) == 18, "is should be 18T");
+BUILD_ASSERT(MORSE_TIMELINE_UNITS(D, U, M, B) == 46, "dumb should be 46T");
 
-		/* Gap between letters (OFF 3T), but not after the last letter */
-		if (i + 1 < num_letters) {
-			led_off_for(led, 3U * T_MS);
+/*
+ * Replay one timeline: { ON, OFF, ON, OFF, ... } in units of T.
+ * Every entry pair is the same two steps, so there is nothing to decide here.
+ */
+static void play_timeline(const struct gpio_dt_spec* led, struct morse_clock* clk,
+                          const struct morse_speed* sp, const uint8_t* units, size_t num_units)
+{
+	for (size_t i = 0; i < num_units; i += 2) {
+		led_on_for(led, clk, morse_speed_on_us(sp, units[i]));
+		if (units[i + 1] == MORSE_WORD_GAP_UNITS) {
+			morse_stats_word(&led_stats[led - gds_leds]);
 		}
+		led_off_for(led, clk, morse_speed_off_us(sp, units[i + 1]));
 	}
-
-	/* Gap between repeats of the word (OFF 7T) */
-	led_off_for(led, 7U * T_MS);
 }
 
 /*
- * HARD-CODED MORSE WORDS (brute force on purpose)
+ * Runtime messages (new text from the shell / UART, see morse_input.h).
  *
- * geoff  = g e o f f = --.  .  ---  ..-.  ..-.
- * cha    = c h a     = -.-. .... .-
- * is     = i s       = ..   ...
- * dumb   = d u m b   = -..  ..-  --  -...
+ * main() writes a new message into the LED's spare buffer and publishes it
+ * (morse_slot.h); the LED thread swaps it in at its next word gap. Neither side
+ * ever waits for the other.
  */
-static void blink_geoff(const struct gpio_dt_spec* led)
-{
-	static const char* const letters[] = {"--.", ".", "---", "..-.", "..-."};
-	blink_word(led, letters, ARRAY_SIZE(letters));
-}
+static struct morse_slot led_slots[NUM_LEDS];     // two message buffers per LED
+static struct morse_msg* led_msgs[NUM_LEDS];      // what each LED plays (NULL = built-in word)
+
+static struct morse_queue input_q;    // shell/UART/telemetry -> main(), lock-free
+K_SEM_DEFINE(input_sem, 0, 1);        // given by the input side after each batch
+
+#if USE_TELEMETRY
+static const struct i2c_dt_spec stts22h = I2C_DT_SPEC_GET(STTS22H_NODE);
+static struct morse_telemetry telemetry;
+#endif
 
-static void blink_cha(const struct gpio_dt_spec* led)
+/*
+ * Replay a bitstream message (1 bit per T) run by run. Only Morse from
+ * morse_bits_encode() comes here: Farnsworth stretches its 3T/7T dark runs.
+ */
+static void play_bits(const struct gpio_dt_spec* led, struct morse_clock* clk,
+                      const struct morse_speed* sp, const uint8_t* bits, size_t nbits)
 {
-	static const char* const letters[] = {"-.-.", "....", ".-"};
-	blink_word(led, letters, ARRAY_SIZE(letters));
+	struct morse_bits_reader rd;
+	uint32_t run;
+	bool on;
+
+	morse_bits_reader_init(&rd, bits, nbits, NULL, NULL);
+	while ((run = morse_bits_next_run(&rd, &on)) != 0U) {
+		if (on) {
+			led_on_for(led, clk, morse_speed_on_us(sp, run));
+		} else {
+			if (run >= MORSE_WORD_GAP_UNITS) {
+				morse_stats_word(&led_stats[led - gds_leds]);
+			}
+			led_off_for(led, clk, morse_speed_off_us(sp, run));
+		}
+	}
 }
 
-static void blink_is(const struct gpio_dt_spec* led)
+/* One repeat of LED idx's word: its runtime message if it has one, else the built-in timeline. */
+static void play_led(size_t idx, const uint8_t* units, size_t num_units)
 {
-	static const char* const letters[] = {"..", "..."};
-	blink_word(led, letters, ARRAY_SIZE(letters));
+	/* Word gap: switch to a new message if main() published one. */
+	struct morse_msg* fresh = morse_slot_take(&led_slots[idx]);
+	if (fresh != NULL) {
+		led_msgs[idx] = fresh;
+	}
+
+	/* ... and to a new speed if the shell asked for one. */
+	uint32_t req = (uint32_t)atomic_get(&led_speed_req[idx]);
+	if (req != led_speed_now[idx] &&
+	    morse_speed_set(&led_speed[idx], MORSE_SPEED_WPM(req), MORSE_SPEED_FWPM(req)) == 0) {
+		led_speed_now[idx] = req;
+		led_clocks[idx].precise = (led_speed[idx].unit_us < PRECISE_BELOW_US);
+	}
+
+	if (led_msgs[idx] != NULL) {
+		play_bits(p_gds_leds[idx], &led_clocks[idx], &led_speed[idx],
+		          led_msgs[idx]->bits, led_msgs[idx]->nbits);
+	} else {
+		play_timeline(p_gds_leds[idx], &led_clocks[idx], &led_speed[idx], units, num_units);
+	}
+
+	/* Right before the next word's first edge: this must cost next to nothing. */
+	LOG_DBG("LED%u word %u, late max %u us", (unsigned)idx, led_stats[idx].words,
+	        led_stats[idx].max_late_us);
 }
 
-static void blink_dumb(const struct gpio_dt_spec* led)
+/* Texts of the batch main() is collecting (main thread only). */
+static char staged_text[NUM_LEDS][MORSE_MSG_MAX + 1];
+static bool staged[NUM_LEDS];
+
+/*
+ * Take everything out of the input queue. Updates are only handed to the LEDs
+ * when the last update of a batch arrives, and then all in one go.
+ */
+static void apply_updates(void)
 {
-	static const char* const letters[] = {"-..", "..-", "--", "-..."};
-	blink_word(led, letters, ARRAY_SIZE(letters));
+	static uint8_t scratch[MORSE_SLOT_BYTES];  // encoded here first, in case it does not fit
+	struct morse_update upd;
+	struct morse_msg* msgs[NUM_LEDS];
+
+	while (morse_queue_pop(&input_q, &upd)) {
+		strcpy(staged_text[upd.chan], upd.text);
+		staged[upd.chan] = true;
+		if (!upd.last) {
+			continue;  // rest of the batch is still coming
+		}
+
+		/*
+		 * 1) Encode the whole batch into the LEDs' spare buffers. A text that
+		 *    fails must not get as far as morse_slot_prepare(): that takes back
+		 *    a message still pending from an earlier batch, which would be lost.
+		 */
+		for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+			if (!staged[idx]) {
+				continue;
+			}
+			int nbits = morse_bits_encode(staged_text[idx], scratch, sizeof(scratch));
+			if (nbits < 0) {
+				LOG_WRN("LED%u: can't send \"%s\" (%d)", (unsigned)idx, staged_text[idx], nbits);
+				staged[idx] = false;
+				continue;
+			}
+			msgs[idx] = morse_slot_prepare(&led_slots[idx]);
+			memcpy(msgs[idx]->bits, scratch, DIV_ROUND_UP((size_t)nbits, 8U));
+			msgs[idx]->nbits = (size_t)nbits;
+		}
+
+		/* 2) Publish them together; each LED switches at its next word gap. */
+		for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+			if (staged[idx]) {
+				morse_slot_publish(&led_slots[idx], msgs[idx]);
+				staged[idx] = false;
+			}
+		}
+	}
 }
 
-/* Thread for LED0: blink "geoff" forever */
+/* Thread for LED0: blink "geoff" forever (or whatever text the shell/UART sends) */
 static void thread_led0(void* p1, void* p2, void* p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	printk("Thread LED0 started (geoff)\n");
+	LOG_INF("Thread LED0 started (geoff)");
+	morse_clock_start(&led_clocks[0], USE_ABS_DEADLINE);
 	while (1) {
-		blink_geoff(p_gds_leds[0]);
+		play_led(0, tl_geoff, ARRAY_SIZE(tl_geoff));
 	}
 };
 
-/* Thread for LED1: blink "cha" forever */
+/* Thread for LED1: blink "cha" forever (or whatever text the shell/UART sends) */
 static void thread_led1(void* p1, void* p2, void* p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	printk("Thread LED1 started (cha)\n");
+	LOG_INF("Thread LED1 started (cha)");
+	morse_clock_start(&led_clocks[1], USE_ABS_DEADLINE);
 	while (1) {
-		blink_cha(p_gds_leds[1]);
+		play_led(1, tl_cha, ARRAY_SIZE(tl_cha));
 	}
 }
 
-/* Thread for LED2: blink "is" forever */
+/* Thread for LED2: blink "is" forever (or whatever text the shell/UART sends) */
 static void thread_led2(void* p1, void* p2, void* p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	printk("Thread LED2 started (is)\n");
+	LOG_INF("Thread LED2 started (is)");
+	morse_clock_start(&led_clocks[2], USE_ABS_DEADLINE);
 	while (1) {
-		blink_is(p_gds_leds[2]);
+		play_led(2, tl_is, ARRAY_SIZE(tl_is));
 	}
 }
 
-/* Thread for LED3: blink "dumb" forever */
+/* Thread for LED3: blink "dumb" forever (or whatever text the shell/UART sends) */
 static void thread_led3(void* p1, void* p2, void* p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	printk("Thread LED3 started (dumb)\n");
+	LOG_INF("Thread LED3 started (dumb)");
+	morse_clock_start(&led_clocks[3], USE_ABS_DEADLINE);
 	while (1) {
-		blink_dumb(p_gds_leds[3]);
+		play_led(3, tl_dumb, ARRAY_SIZE(tl_dumb));
 	}
 }
 
@@ -200,33 +401,104 @@ int main(void)
 		return 0;  // returning from main() stops the program on the MCU
 	}
 
-	printk("Starting threads...\n");
+	/* Every LED starts at START_WPM; the threads pick it up before their first word. */
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		atomic_set(&led_speed_req[idx], (atomic_val_t)MORSE_SPEED_PACK(START_WPM, 0));
+	}
+
+	/* Runtime messages and speeds can come in from here on. */
+	morse_queue_init(&input_q);
+	morse_input_speeds(led_speed_req);
+	ret = morse_input_init(&input_q, &input_sem, NUM_LEDS);
+	if (ret < 0) {
+		LOG_WRN("Morse UART not ready (%d), shell input only", ret);
+	}
+
+#if USE_TELEMETRY
+	/* LED3 sends the temperature instead of its word (the sensor is optional). */
+	ret = morse_telemetry_start(&telemetry, &stts22h, &input_q, &input_sem, TELEMETRY_LED, TELEMETRY_MS);
+	if (ret < 0) {
+		LOG_WRN("STTS22H not found (%d), LED%u keeps its word", ret, TELEMETRY_LED);
+	}
+#endif
+
+	morse_stats_init(led_stats, NUM_LEDS, thread_datas, NUM_LEDS);
+
+	LOG_INF("Starting threads...");
 	k_msleep(500);
 
-	/* 2) Create one Morse thread per LED. */
+	/* 2) Create one Morse thread per LED (not started yet, so it can still be pinned). */
 	thread_tids[0] = k_thread_create(&(thread_datas[0]), thread_stacks[0],
 	                                K_KERNEL_STACK_SIZEOF(thread_stacks[0]),
 	                                thread_led0, NULL, NULL, NULL,
-	                                MY_PRIORITY, 0, K_NO_WAIT);
+	                                MY_PRIORITY, 0, K_FOREVER);
 
 	thread_tids[1] = k_thread_create(&(thread_datas[1]), thread_stacks[1],
 	                                K_KERNEL_STACK_SIZEOF(thread_stacks[1]),
 	                                thread_led1, NULL, NULL, NULL,
-	                                MY_PRIORITY, 0, K_NO_WAIT);
+	                                MY_PRIORITY, 0, K_FOREVER);
 
 	thread_tids[2] = k_thread_create(&(thread_datas[2]), thread_stacks[2],
 	                                K_KERNEL_STACK_SIZEOF(thread_stacks[2]),
 	                                thread_led2, NULL, NULL, NULL,
-	                                MY_PRIORITY, 0, K_NO_WAIT);
+	                                MY_PRIORITY, 0, K_FOREVER);
 
 	thread_tids[3] = k_thread_create(&(thread_datas[3]), thread_stacks[3],
 	                                K_KERNEL_STACK_SIZEOF(thread_stacks[3]),
 	                                thread_led3, NULL, NULL, NULL,
-	                                MY_PRIORITY, 0, K_NO_WAIT);
+	                                MY_PRIORITY, 0, K_FOREVER);
 
-	/* 3) main thread goes idle; blinking happens in the worker threads. */
+	/* SMP pinned mode: the LED threads get a CPU to themselves; then they start. */
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		ret = morse_smp_pin_led(thread_tids[idx]);
+		if (ret < 0) {
+			LOG_ERR("LED%u: cannot pin to CPU %u (%d)", (unsigned)idx, MORSE_SMP_LED_CPU, ret);
+		}
+		k_thread_start(thread_tids[idx]);
+	}
+
+#ifndef MORSE_LOWPOWER
+	/* Competing work at the same priority as the LEDs ("morse load"). */
+	morse_load_start(MY_PRIORITY, MORSE_LOAD_MS);
+#endif
+
+	/*
+	 * 3) main thread hands new messages from the shell/UART to the LEDs, and
+	 *    reports how late the LED edges are every REPORT_MS.
+	 */
+#ifdef MORSE_LOWPOWER
+	/* Low-power mode: no periodic report, main() only wakes up for new input. */
+	while (1) {
+		k_sem_take(&input_sem, K_FOREVER);
+		apply_updates();
+	}
+#else
+	struct morse_smp_window report_cpu_window = { 0 };  // per-CPU load since the last report
+	int64_t next_report = k_uptime_get() + REPORT_MS;
 	while (1) {
-		k_msleep(1000);
+		k_sem_take(&input_sem, K_TIMEOUT_ABS_MS(next_report));
+		apply_updates();
+
+		if (k_uptime_get() < next_report) {
+			continue;  // woken up by new input, not time for a report yet
+		}
+		next_report += REPORT_MS;
+		LOG_INF("%s scheduling, load %u/%u ms", IS_ENABLED(MORSE_EDF) ? "EDF" : "fixed priority",
+		       (uint32_t)atomic_get(&load_busy_ms), (uint32_t)atomic_get(&load_period_ms));
+		for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+			LOG_INF("LED%u: %u edges, late last %u us, max %u us", (unsigned)idx,
+			       led_clocks[idx].edges,
+			       k_ticks_to_us_floor32((uint32_t)led_clocks[idx].last_late),
+			       k_ticks_to_us_floor32((uint32_t)led_clocks[idx].max_late));
+		}
+		for (int cpu = 0; cpu < MORSE_SMP_CPUS && IS_ENABLED(CONFIG_SMP); cpu++) {
+			int busy = morse_smp_busy(&report_cpu_window, cpu);
+			if (busy < 0) {
+				break;  // no per-CPU statistics in this build (-ENOTSUP)
+			}
+			LOG_INF("CPU%d: %d.%d %% busy", cpu, busy / 10, busy % 10);
+		}
 	}
+#endif
 	return 0;
 }
@@ -0,0 +1,127 @@
+/*
+ * main_morse_dt.c
+ *
+ * Every LED, its message and its speed come from the devicetree (a
+ * "geoffcha,morse-channels" node, see dts/bindings/). Nothing here knows how
+ * many channels there are: add child nodes and the same code drives 4 or 64
+ * LEDs, on SoC GPIOs or GPIO expanders.
+ *
+ * A channel sends its message in Morse, or as a line-coded frame (NRZ or
+ * Manchester, morse_line.h) when its node says line-code = "nrz" /
+ * "manchester". Both are bitstreams, so the player does not care which.
+ *
+ * The channels are played by the one-timer scheduler (morse_sched.h), so an
+ * extra LED costs a struct morse_chan, a bitstream reader and its message
+ * bits, a few dozen bytes, instead of a thread with a 1 KB stack.
+ *
+ * native_sim: 4 channels by default, 64 with
+ *   -DEXTRA_DTC_OVERLAY_FILE=boards/morse_channels_64.overlay
+ */
+
+#include <string.h>               // strlen()
+#include <zephyr/kernel.h>        // k_sleep(), printk()
+#include <zephyr/devicetree.h>    // DT_FOREACH_CHILD_STATUS_OKAY()
+#include <zephyr/drivers/gpio.h>  // GPIO_DT_SPEC_GET()
+#include <zephyr/sys/util.h>      // ARRAY_SIZE, MAX
+#include <leds_funcs.h>           // setup_leds()
+#include <morse_sched.h>          // morse_sched_start(): one timer for every LED
+#include <morse_bits.h>           // morse_bits_encode(): text -> 1 bit per unit
+#include <morse_line.h>           // morse_line_encode(): bytes -> NRZ/Manchester frame
+
+#define CHANNELS_NODE DT_INST(0, geoffcha_morse_channels)
+#define NUM_CHANS DT_CHILD_NUM_STATUS_OKAY(CHANNELS_NODE)
+
+BUILD_ASSERT(NUM_CHANS > 0, "morse-channels node has no channels");
+BUILD_ASSERT(NUM_CHANS <= MORSE_SCHED_MAX_CHANS, "too many channels for morse_sched");
+
+/* Per channel, straight from the devicetree (all in flash). */
+#define CHAN_LED(node) GPIO_DT_SPEC_GET(node, gpios),
+#define CHAN_TEXT(node) DT_PROP(node, message),
+#define CHAN_UNIT_MS(node) DT_PROP_OR(node, unit_ms, DT_PROP(CHANNELS_NODE, unit_ms)),
+#define CHAN_CODE(node) DT_ENUM_IDX(node, line_code),
+
+/* line-code values, in the order of the binding's enum. */
+enum chan_code {
+	CHAN_MORSE,
+	CHAN_NRZ,
+	CHAN_MANCHESTER,
+};
+
+static const struct gpio_dt_spec chan_leds[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_LED) };
+static const char* const chan_texts[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_TEXT) };
+static const uint16_t chan_unit_ms[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_UNIT_MS) };
+static const uint8_t chan_codes[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_CODE) };
+
+/*
+ * All messages are encoded at boot into one shared pool, each right after the
+ * previous one. The pool is sized for the worst case of every message, Morse
+ * or frame (sizeof() of the string includes its NUL, which pays for rounding
+ * up to whole bytes).
+ */
+#define CHAN_MORSE_BYTES(node) MORSE_BITS_BYTES(MORSE_BITS_MAX_PER_CHAR * sizeof(DT_PROP(node, message)))
+#define CHAN_FRAME_BYTES(node) MORSE_BITS_BYTES(MORSE_LINE_FRAME_UNITS(MORSE_LINE_MANCHESTER, sizeof(DT_PROP(node, message))))
+#define CHAN_POOL_BYTES(node) + MAX(CHAN_MORSE_BYTES(node), CHAN_FRAME_BYTES(node))
+static uint8_t msg_pool[0 DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_POOL_BYTES)];
+
+static struct morse_bits_reader chan_msgs[NUM_CHANS];
+static struct morse_chan chans[NUM_CHANS];
+static struct morse_sched sched;
+
+/* Encode channel idx's message the way its node asks into buf. Returns bits, or a negative error. */
+static int encode_chan(size_t idx, uint8_t* buf, size_t buf_len)
+{
+	const char* text = chan_texts[idx];
+
+	switch (chan_codes[idx]) {
+	case CHAN_NRZ:
+		return morse_line_encode(MORSE_LINE_NRZ, (const uint8_t*)text, strlen(text), buf, buf_len);
+	case CHAN_MANCHESTER:
+		return morse_line_encode(MORSE_LINE_MANCHESTER, (const uint8_t*)text, strlen(text), buf, buf_len);
+	default:
+		return morse_bits_encode(text, buf, buf_len);
+	}
+}
+
+int main(void)
+{
+	const struct gpio_dt_spec* p_leds[NUM_CHANS];
+	size_t used = 0;  // bytes of msg_pool taken so far
+
+	/* 1) Configure all LED pins as outputs (start OFF). */
+	for (size_t idx = 0; idx < NUM_CHANS; idx++) {
+		p_leds[idx] = &chan_leds[idx];
+	}
+	int ret = setup_leds(p_leds, NUM_CHANS);
+	if (ret < 0) {
+		return 0;  // returning from main() stops the program on the MCU
+	}
+
+	/* 2) Encode each message and hook it to its channel. */
+	for (size_t idx = 0; idx < NUM_CHANS; idx++) {
+		ret = encode_chan(idx, &msg_pool[used], sizeof(msg_pool) - used);
+		if (ret < 0) {
+			printk("channel %u: cannot encode \"%s\" (%d)\n", (unsigned)idx, chan_texts[idx], ret);
+			return 0;
+		}
+		morse_bits_reader_init(&chan_msgs[idx], &msg_pool[used], (size_t)ret, NULL, NULL);
+		used += MORSE_BITS_BYTES((size_t)ret);
+
+		chans[idx].led = &chan_leds[idx];
+		chans[idx].bits = &chan_msgs[idx];
+		chans[idx].unit_ms = chan_unit_ms[idx];
+	}
+
+	printk("Starting Morse scheduler (%u channels from devicetree, %u message bytes)...\n",
+	       (unsigned)NUM_CHANS, (unsigned)used);
+
+	/* 3) One timer plays every channel from here on. */
+	ret = morse_sched_start(&sched, chans, NUM_CHANS, DT_PROP(CHANNELS_NODE, unit_ms));
+	if (ret < 0) {
+		printk("morse_sched_start failed (%d)\n", ret);
+		return 0;
+	}
+
+	/* 4) main thread has nothing left to do; the timer does the blinking. */
+	k_sleep(K_FOREVER);
+	return 0;
+}
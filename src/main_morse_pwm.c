@@ -0,0 +1,104 @@
+/*
+ * main_morse_pwm.c
+ *
+ * The devicetree channels of main_morse_dt.c, dimmed and with soft edges:
+ * every channel has a brightness and a raised-cosine fade on each mark
+ * (brightness / ramp-ms in the "geoffcha,morse-channels" node), all driven
+ * by the software PWM engine in morse_pwm.h from ONE timer.
+ *
+ * Change them while it runs:
+ *   uart:~$ morse pwm 0 20 8       (channel 0 at 20 %, 8 ms fades)
+ *
+ * The PWM step needs a fast kernel tick: with the 100 us step below,
+ * CONFIG_SYS_CLOCK_TICKS_PER_SECOND must be at least 10000 (it is on
+ * native_sim), otherwise steps are rounded up to whole ticks and the LEDs
+ * visibly flicker.
+ */
+
+#include <zephyr/kernel.h>        // k_sleep(), printk()
+#include <zephyr/devicetree.h>    // DT_FOREACH_CHILD_STATUS_OKAY()
+#include <zephyr/drivers/gpio.h>  // GPIO_DT_SPEC_GET()
+#include <zephyr/sys/util.h>      // ARRAY_SIZE
+#include <leds_funcs.h>           // setup_leds()
+#include <morse_pwm.h>            // morse_pwm_start(): one timer, PWM for every LED
+#include <morse_bits.h>           // morse_bits_encode(): text -> 1 bit per unit
+
+/* One PWM step; a frame is MORSE_PWM_STEPS of them (1.6 ms, 625 Hz). */
+#define PWM_STEP_US 100
+
+#define CHANNELS_NODE DT_INST(0, geoffcha_morse_channels)
+#define NUM_CHANS DT_CHILD_NUM_STATUS_OKAY(CHANNELS_NODE)
+
+BUILD_ASSERT(NUM_CHANS > 0, "morse-channels node has no channels");
+BUILD_ASSERT(NUM_CHANS <= MORSE_PWM_MAX_CHANS, "too many channels for morse_pwm");
+
+/* Per channel, straight from the devicetree (all in flash). */
+#define CHAN_LED(node) GPIO_DT_SPEC_GET(node, gpios),
+#define CHAN_TEXT(node) DT_PROP(node, message),
+#define CHAN_UNIT_MS(node) DT_PROP_OR(node, unit_ms, DT_PROP(CHANNELS_NODE, unit_ms)),
+#define CHAN_BRIGHTNESS(node) DT_PROP(node, brightness),
+#define CHAN_RAMP_MS(node) DT_PROP(node, ramp_ms),
+
+static const struct gpio_dt_spec chan_leds[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_LED) };
+static const char* const chan_texts[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_TEXT) };
+static const uint16_t chan_unit_ms[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_UNIT_MS) };
+static const uint8_t chan_brightness[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_BRIGHTNESS) };
+static const uint16_t chan_ramp_ms[] = { DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_RAMP_MS) };
+
+/* All messages encoded at boot into one pool (sized as in main_morse_dt.c). */
+#define CHAN_POOL_BYTES(node) + MORSE_BITS_BYTES(MORSE_BITS_MAX_PER_CHAR * sizeof(DT_PROP(node, message)))
+static uint8_t msg_pool[0 DT_FOREACH_CHILD_STATUS_OKAY(CHANNELS_NODE, CHAN_POOL_BYTES)];
+
+static struct morse_bits_reader chan_msgs[NUM_CHANS];
+static struct morse_pwm_chan chans[NUM_CHANS];
+static struct morse_pwm pwm;
+
+int main(void)
+{
+	const struct gpio_dt_spec* p_leds[NUM_CHANS];
+	size_t used = 0;  // bytes of msg_pool taken so far
+
+	/* 1) Configure all LED pins as outputs (start OFF). */
+	for (size_t idx = 0; idx < NUM_CHANS; idx++) {
+		p_leds[idx] = &chan_leds[idx];
+	}
+	int ret = setup_leds(p_leds, NUM_CHANS);
+	if (ret < 0) {
+		return 0;  // returning from main() stops the program on the MCU
+	}
+
+	/* 2) Encode each message and hook it to its channel. */
+	for (size_t idx = 0; idx < NUM_CHANS; idx++) {
+		ret = morse_bits_encode(chan_texts[idx], &msg_pool[used], sizeof(msg_pool) - used);
+		if (ret < 0) {
+			printk("channel %u: cannot encode \"%s\" (%d)\n", (unsigned)idx, chan_texts[idx], ret);
+			return 0;
+		}
+		morse_bits_reader_init(&chan_msgs[idx], &msg_pool[used], (size_t)ret, NULL, NULL);
+		used += MORSE_BITS_BYTES((size_t)ret);
+
+		chans[idx].led = &chan_leds[idx];
+		chans[idx].bits = &chan_msgs[idx];
+		chans[idx].unit_ms = chan_unit_ms[idx];
+		chans[idx].brightness = (uint8_t)((MIN(chan_brightness[idx], 100U) * MORSE_PWM_STEPS + 50U) / 100U);
+	}
+
+	/* 3) One timer plays and dims every channel from here on. */
+	ret = morse_pwm_start(&pwm, chans, NUM_CHANS, DT_PROP(CHANNELS_NODE, unit_ms), PWM_STEP_US);
+	if (ret < 0) {
+		printk("morse_pwm_start failed (%d)\n", ret);
+		return 0;
+	}
+
+	/* Ramps are in frames, known once the engine has worked out the frame length. */
+	for (size_t idx = 0; idx < NUM_CHANS; idx++) {
+		chans[idx].ramp_frames = (uint8_t)MIN(chan_ramp_ms[idx] * 1000U / pwm.frame_us, UINT8_MAX);
+	}
+
+	printk("Morse PWM: %u channels, %u us frames, %u levels\n", (unsigned)NUM_CHANS, pwm.frame_us,
+	       MORSE_PWM_STEPS);
+
+	/* 4) main thread has nothing left to do; the timer does the blinking. */
+	k_sleep(K_FOREVER);
+	return 0;
+}
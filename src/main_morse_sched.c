@@ -0,0 +1,156 @@
+/*
+ * main_morse_sched.c
+ *
+ * Same four words as main_morse_Geoff.c, but with NO worker threads:
+ * one k_timer plays all LEDs (see morse_sched.h).
+ *
+ * main_morse_Geoff.c needs 4 x 1024 byte stacks + 4 struct k_thread.
+ * Here each LED is just a struct morse_chan, and the CPU only wakes up
+ * when some LED actually has to change.
+ *
+ * With a flash message store (morse_store.h, "geoffcha,morse-store" chosen
+ * in the devicetree) every LED that has messages there plays those instead,
+ * straight out of flash. An empty store is filled with the words below on
+ * the first boot.
+ */
+
+#include <zephyr/kernel.h>        // k_sleep(), printk()
+#include <zephyr/devicetree.h>    // DT_HAS_CHOSEN()
+#include <zephyr/drivers/gpio.h>  // GPIO types for LEDs
+#include <zephyr/sys/util.h>      // ARRAY_SIZE
+#include <leds_funcs.h>           // setup_leds()
+#include <morse_timeline.h>       // MORSE_TIMELINE_DEFINE()
+#include <morse_sched.h>          // morse_sched_start(): one timer for every LED
+#include <morse_bits.h>           // morse_bits_encode(): text -> 1 bit per unit
+#ifdef MORSE_LOWPOWER
+#include <morse_power.h>          // "morse power": wakeups and idle time
+#endif
+
+#if DT_HAS_CHOSEN(geoffcha_morse_store)
+#include <morse_store.h>          // pre-encoded messages in flash, played in place
+#define USE_STORE 1
+#else
+#define USE_STORE 0
+#endif
+
+/* Morse timing uses a base unit "T" (milliseconds). */
+#define T_MS 150
+
+#define NUM_LEDS 4
+
+/*
+ * Low-power mode: edges up to this far apart are played in one wakeup. Far
+ * below what the eye (or a Morse receiver, see morse_rx.h) can notice at T = 150 ms.
+ */
+#define LOWPOWER_SLACK_MS 5
+
+/* Devicetree: get the board's LED nodes (led0, led1, led2, led3). */
+#define LED0_NODE DT_NODELABEL(led0)
+#define LED1_NODE DT_NODELABEL(led1)
+#define LED2_NODE DT_NODELABEL(led2)
+#define LED3_NODE DT_NODELABEL(led3)
+
+static const struct gpio_dt_spec gds_leds[NUM_LEDS] = {
+	GPIO_DT_SPEC_GET(LED0_NODE, gpios),
+	GPIO_DT_SPEC_GET(LED1_NODE, gpios),
+	GPIO_DT_SPEC_GET(LED2_NODE, gpios),
+	GPIO_DT_SPEC_GET(LED3_NODE, gpios),
+};
+
+static const struct gpio_dt_spec* p_gds_leds[NUM_LEDS] = {
+	&gds_leds[0], &gds_leds[1], &gds_leds[2], &gds_leds[3]
+};
+
+/* Words in flash, built by the preprocessor. */
+MORSE_TIMELINE_DEFINE(tl_geoff, G, E, O, F, F);
+MORSE_TIMELINE_DEFINE(tl_cha, C, H, A);
+MORSE_TIMELINE_DEFINE(tl_is, I, S);
+
+/*
+ * LED3 sends a whole sentence instead of one word. Packed one bit per unit it
+ * is encoded once at boot and then streamed (see morse_bits.h).
+ */
+#define LONG_MESSAGE "geoff cha is dumb"
+static uint8_t long_msg_bits[32];
+static struct morse_bits_reader long_msg;
+
+/* One channel per LED: which LED + which timeline (or bitstream). */
+static struct morse_chan chans[NUM_LEDS] = {
+	{ .led = &gds_leds[0], .units = tl_geoff, .num_units = ARRAY_SIZE(tl_geoff) },
+	{ .led = &gds_leds[1], .units = tl_cha,   .num_units = ARRAY_SIZE(tl_cha) },
+	{ .led = &gds_leds[2], .units = tl_is,    .num_units = ARRAY_SIZE(tl_is) },
+	{ .led = &gds_leds[3], .bits = &long_msg },
+};
+
+static struct morse_sched sched;
+
+#if USE_STORE
+static struct morse_store store;
+static struct morse_store_cursor store_cursors[NUM_LEDS];
+static struct morse_bits_reader store_readers[NUM_LEDS];
+
+/* Words for an empty store, one per LED. */
+static const char* const store_seed[NUM_LEDS] = { "geoff", "cha", "is", LONG_MESSAGE };
+
+/* Load the store (filling it on the first boot) and switch LEDs with stored messages to it. */
+static void use_store(void)
+{
+	int ret = morse_store_init(&store);
+	if (ret < 0) {
+		printk("No message store (%d), built-in words only\n", ret);
+		return;
+	}
+
+	if (store.count == 0U) {
+		for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+			ret = morse_store_add(&store, (uint8_t)idx, store_seed[idx]);
+			if (ret < 0) {
+				printk("Can't fill the message store (%d)\n", ret);
+				return;
+			}
+		}
+		morse_store_init(&store);  // load what we just wrote (nothing plays yet)
+	}
+
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		if (morse_store_reader(&store, &store_cursors[idx], (uint8_t)idx, &store_readers[idx])) {
+			chans[idx].bits = &store_readers[idx];
+		}
+	}
+	printk("Message store: %u messages\n", store.count);
+}
+#endif
+
+int main(void)
+{
+	/* 1) Configure all LED pins as outputs (start OFF). */
+	int ret = setup_leds(p_gds_leds, NUM_LEDS);
+	if (ret < 0) {
+		return 0;  // returning from main() stops the program on the MCU
+	}
+
+	ret = morse_bits_encode(LONG_MESSAGE, long_msg_bits, sizeof(long_msg_bits));
+	if (ret < 0) {
+		return 0;  // message does not fit in long_msg_bits[]
+	}
+	morse_bits_reader_init(&long_msg, long_msg_bits, (size_t)ret, NULL, NULL);
+
+#if USE_STORE
+	use_store();
+#endif
+
+	printk("Starting Morse scheduler (%u LEDs, 1 timer)...\n", NUM_LEDS);
+
+	/* 2) One timer plays every LED from here on. */
+#ifdef MORSE_LOWPOWER
+	sched.slack_ticks = k_ms_to_ticks_floor64(LOWPOWER_SLACK_MS);
+#endif
+	ret = morse_sched_start(&sched, chans, NUM_LEDS, T_MS);
+	if (ret < 0) {
+		return 0;
+	}
+
+	/* 3) main thread sleeps for good; the timer does the blinking. */
+	k_sleep(K_FOREVER);
+	return 0;
+}
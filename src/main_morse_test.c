@@ -18,6 +18,7 @@
 #include <zephyr/kernel.h>        // k_msleep(), printk()
 #include <zephyr/drivers/gpio.h>  // GPIO control for LEDs
 #include <leds_funcs.h>           // setup_leds()
+#include <morse.h>                // morse_lookup(): letter -> dots/dashes
 
 /* Morse timing uses a base unit "T" (milliseconds). */
 #define T_MS 150
@@ -66,22 +67,23 @@ static void gap_3T(const struct gpio_dt_spec* led) { led_off(led); sleep_ms(3U *
 static void gap_7T(const struct gpio_dt_spec* led) { led_off(led); sleep_ms(7U * T_MS); }
 
 /*
- * Blink one letter given as a pattern string:
- *   "."  means dot
- *   "-"  means dash
- * Example: 'c' is "-.-."
+ * Blink one letter given as a packed code from morse_table[] (see morse.h):
+ *   bit 0 = next symbol (1 = dash, 0 = dot), then shift right.
+ * When only the top "sentinel" 1 bit is left, the letter is done.
+ * Example: 'c' is -.-. -> 0x15
  */
-static void blink_letter(const struct gpio_dt_spec* led, const char* pattern)
+static void blink_letter(const struct gpio_dt_spec* led, uint8_t code)
 {
-	for (size_t i = 0; pattern[i] != '\0'; i++) {
-		if (pattern[i] == '.') {
-			dot(led);
-		} else if (pattern[i] == '-') {
+	while (code > 1U) {
+		if (code & 1U) {
 			dash(led);
+		} else {
+			dot(led);
 		}
+		code >>= 1;
 
 		/* If there is another symbol coming, add the 1T symbol gap */
-		if (pattern[i + 1] != '\0') {
+		if (code > 1U) {
 			gap_1T(led);
 		}
 	}
@@ -93,60 +95,26 @@ static void letter_gap(const struct gpio_dt_spec* led) { gap_3T(led); }
 /* After a word finishes, we want a 7T gap before repeating / next word. */
 static void word_gap(const struct gpio_dt_spec* led) { gap_7T(led); }
 
-/* --- Word functions (hard-coded so it's easy to read) --- */
-
-/* geoff = g e o f f */
-static void blink_geoff(const struct gpio_dt_spec* led)
-{
-	/* g = --. */
-	blink_letter(led, "--."); letter_gap(led);
-	/* e = . */
-	blink_letter(led, ".");   letter_gap(led);
-	/* o = --- */
-	blink_letter(led, "---"); letter_gap(led);
-	/* f = ..-. */
-	blink_letter(led, "..-."); letter_gap(led);
-	/* f = ..-. */
-	blink_letter(led, "..-.");
-
-	word_gap(led);
-}
-
-/* chavez = c h a v e z */
-static void blink_chavez(const struct gpio_dt_spec* led)
-{
-	blink_letter(led, "-.-."); letter_gap(led);  /* c */
-	blink_letter(led, "...."); letter_gap(led);  /* h */
-	blink_letter(led, ".-");   letter_gap(led);  /* a */
-	blink_letter(led, "...-"); letter_gap(led);  /* v */
-	blink_letter(led, ".");    letter_gap(led);  /* e */
-	blink_letter(led, "--..");                 /* z */
-
-	word_gap(led);
-}
-
-/* likes = l i k e s */
-static void blink_likes(const struct gpio_dt_spec* led)
+/*
+ * Blink one word, e.g. "Geoff". Each character is looked up in morse_table[],
+ * so any word works without writing a new function for it.
+ */
+static void blink_text(const struct gpio_dt_spec* led, const char* word)
 {
-	blink_letter(led, ".-.."); letter_gap(led);  /* l */
-	blink_letter(led, "..");   letter_gap(led);  /* i */
-	blink_letter(led, "-.-");  letter_gap(led);  /* k */
-	blink_letter(led, ".");    letter_gap(led);  /* e */
-	blink_letter(led, "...");                 /* s */
+	bool first = true;  // no letter gap before the first letter
 
-	word_gap(led);
-}
+	for (size_t i = 0; word[i] != '\0'; i++) {
+		uint8_t code = morse_lookup(word[i]);
+		if (code == MORSE_CODE_NONE || code == MORSE_CODE_SPACE) {
+			continue;  // only letters/digits/punctuation blink
+		}
 
-/* digimon = d i g i m o n */
-static void blink_digimon(const struct gpio_dt_spec* led)
-{
-	blink_letter(led, "-.."); letter_gap(led);   /* d */
-	blink_letter(led, "..");  letter_gap(led);   /* i */
-	blink_letter(led, "--."); letter_gap(led);   /* g */
-	blink_letter(led, "..");  letter_gap(led);   /* i */
-	blink_letter(led, "--");  letter_gap(led);   /* m */
-	blink_letter(led, "---"); letter_gap(led);   /* o */
-	blink_letter(led, "-.");                  /* n */
+		if (!first) {
+			letter_gap(led);
+		}
+		blink_letter(led, code);
+		first = false;
+	}
 
 	word_gap(led);
 }
@@ -164,10 +132,10 @@ int main(void)
 
 	/* 2) Loop forever. One LED at a time (sequential). */
 	while (1) {
-		blink_geoff(p_leds[0]);    // LED0 says "Geoff"
-		blink_chavez(p_leds[1]);   // LED1 says "Chavez"
-		blink_likes(p_leds[2]);    // LED2 says "likes"
-		blink_digimon(p_leds[3]);  // LED3 says "Digimon"
+		blink_text(p_leds[0], "Geoff");    // LED0 says "Geoff"
+		blink_text(p_leds[1], "Chavez");   // LED1 says "Chavez"
+		blink_text(p_leds[2], "likes");    // LED2 says "likes"
+		blink_text(p_leds[3], "Digimon");  // LED3 says "Digimon"
 	}
 }
 
@@ -0,0 +1,295 @@
+/*
+ * Encoder tests: morse_lookup(), morse_code_len() and morse_encode_units(),
+ * the build-time timelines of morse_timeline.h, made from the same chart,
+ * and the WPM / Farnsworth timing of morse_speed.h.
+ *
+ * The expected codes are written as dots and dashes from the ITU chart
+ * (ITU-R M.1677-1) and packed here by chart_code(), NOT copied from
+ * morse_table[], so a wrong table entry is caught.
+ */
+
+#include <string.h>               // strlen(), memset()
+#include <zephyr/ztest.h>
+#include <zephyr/sys/util.h>      // ARRAY_SIZE
+#include <morse.h>                // (under test)
+#include <morse_timeline.h>       // (under test)
+#include <morse_speed.h>          // (under test)
+
+struct chart_entry {
+	char c;
+	const char* code;  // '.' and '-'
+};
+
+static const struct chart_entry letters[] = {
+	{ 'A', ".-" },   { 'B', "-..." }, { 'C', "-.-." }, { 'D', "-.." },  { 'E', "." },
+	{ 'F', "..-." }, { 'G', "--." },  { 'H', "...." }, { 'I', ".." },   { 'J', ".---" },
+	{ 'K', "-.-" },  { 'L', ".-.." }, { 'M', "--" },   { 'N', "-." },   { 'O', "---" },
+	{ 'P', ".--." }, { 'Q', "--.-" }, { 'R', ".-." },  { 'S', "..." },  { 'T', "-" },
+	{ 'U', "..-" },  { 'V', "...-" }, { 'W', ".--" },  { 'X', "-..-" }, { 'Y', "-.--" },
+	{ 'Z', "--.." },
+};
+
+static const struct chart_entry digits[] = {
+	{ '0', "-----" }, { '1', ".----" }, { '2', "..---" }, { '3', "...--" }, { '4', "....-" },
+	{ '5', "....." }, { '6', "-...." }, { '7', "--..." }, { '8', "---.." }, { '9', "----." },
+};
+
+static const struct chart_entry punctuation[] = {
+	{ '.', ".-.-.-" }, { ',', "--..--" }, { '?', "..--.." }, { '\'', ".----." }, { '!', "-.-.--" },
+	{ '/', "-..-." },  { '(', "-.--." },  { ')', "-.--.-" }, { '&', ".-..." },   { ':', "---..." },
+	{ ';', "-.-.-." }, { '=', "-...-" },  { '+', ".-.-." },  { '-', "-....-" },  { '_', "..--.-" },
+	{ '"', ".-..-." }, { '$', "...-..-" }, { '@', ".--.-." },
+};
+
+static const struct chart_entry prosigns[] = {
+	{ MORSE_PROSIGN_CT, "-.-.-" }, { MORSE_PROSIGN_SK, "...-.-" }, { MORSE_PROSIGN_SN, "...-." },
+	{ MORSE_PROSIGN_AR, ".-.-." }, { MORSE_PROSIGN_BT, "-...-" },  { MORSE_PROSIGN_KN, "-.--." },
+	{ MORSE_PROSIGN_AS, ".-..." },
+};
+
+/* Dots and dashes -> packed code: first element in bit 0, sentinel above the last. */
+static uint8_t chart_code(const char* code)
+{
+	size_t len = strlen(code);
+	uint8_t packed = (uint8_t)(1U << len);
+
+	for (size_t i = 0; i < len; i++) {
+		if (code[i] == '-') {
+			packed |= (uint8_t)(1U << i);
+		}
+	}
+	return packed;
+}
+
+static void check_chart(const struct chart_entry* chart, size_t num)
+{
+	for (size_t i = 0; i < num; i++) {
+		uint8_t code = morse_lookup(chart[i].c);
+
+		zassert_equal(code, chart_code(chart[i].code), "'%c' (0x%02x): got 0x%02x, chart says %s",
+		              chart[i].c, (unsigned)chart[i].c, code, chart[i].code);
+		zassert_equal(morse_code_len(code), strlen(chart[i].code), "'%c': wrong length", chart[i].c);
+	}
+}
+
+/* --- morse_lookup() --- */
+
+ZTEST(morse_encode, test_lookup_letters)
+{
+	check_chart(letters, ARRAY_SIZE(letters));
+
+	for (size_t i = 0; i < ARRAY_SIZE(letters); i++) {
+		char lower = (char)(letters[i].c - 'A' + 'a');
+		zassert_equal(morse_lookup(lower), morse_lookup(letters[i].c), "'%c' differs from '%c'", lower,
+		              letters[i].c);
+	}
+}
+
+ZTEST(morse_encode, test_lookup_digits)
+{
+	check_chart(digits, ARRAY_SIZE(digits));
+}
+
+ZTEST(morse_encode, test_lookup_punctuation)
+{
+	check_chart(punctuation, ARRAY_SIZE(punctuation));
+}
+
+ZTEST(morse_encode, test_lookup_prosigns)
+{
+	check_chart(prosigns, ARRAY_SIZE(prosigns));
+}
+
+ZTEST(morse_encode, test_lookup_space_and_unknown)
+{
+	static const char unknown[] = { '\0', '\n', '\t', '#', '%', '*', '<', '>', '[', '\\', ']', '^', '`',
+	                                '{', '|', '}', '~', 0x7F, (char)0x80, (char)0xE9, (char)0xFF };
+
+	zassert_equal(morse_lookup(' '), MORSE_CODE_SPACE);
+	for (size_t i = 0; i < ARRAY_SIZE(unknown); i++) {
+		zassert_equal(morse_lookup(unknown[i]), MORSE_CODE_NONE, "0x%02x has a code",
+		              (unsigned)(unsigned char)unknown[i]);
+	}
+}
+
+/* --- morse_code_len() --- */
+
+ZTEST(morse_encode, test_code_len)
+{
+	zassert_equal(morse_code_len(MORSE_CODE_NONE), 0U);
+	zassert_equal(morse_code_len(MORSE_CODE_SPACE), 0U);
+	zassert_equal(morse_code_len(morse_lookup('E')), 1U);
+	zassert_equal(morse_code_len(morse_lookup('T')), 1U);
+	zassert_equal(morse_code_len(morse_lookup('0')), 5U);
+	zassert_equal(morse_code_len(morse_lookup('$')), MORSE_MAX_ELEMENTS);
+	zassert_equal(morse_code_len(0xFF), MORSE_MAX_ELEMENTS);
+}
+
+/* --- morse_encode_units() --- */
+
+/* Encode text into a fresh buffer and compare with the expected ON/OFF timeline. */
+static void check_units(const char* text, const uint8_t* want, size_t num_want)
+{
+	uint8_t units[64];
+
+	memset(units, 0xAA, sizeof(units));
+	int n = morse_encode_units(text, units, sizeof(units));
+
+	zassert_equal(n, (int)num_want, "\"%s\": %d entries, want %u", text, n, (unsigned)num_want);
+	zassert_mem_equal(units, want, num_want, "\"%s\": wrong timeline", text);
+}
+
+ZTEST(morse_encode, test_encode_letter_gaps)
+{
+	/* e = .   t = -   a = .-  */
+	check_units("e", (const uint8_t[]){ 1, 7 }, 2);
+	check_units("et", (const uint8_t[]){ 1, 3, 3, 7 }, 4);
+	check_units("a", (const uint8_t[]){ 1, 1, 3, 7 }, 4);
+	check_units("sos", (const uint8_t[]){ 1, 1, 1, 1, 1, 3, 3, 1, 3, 1, 3, 3, 1, 1, 1, 1, 1, 7 }, 18);
+}
+
+ZTEST(morse_encode, test_encode_word_gaps)
+{
+	check_units("e t", (const uint8_t[]){ 1, 7, 3, 7 }, 4);
+
+	/* Leading, trailing and repeated spaces make no extra gaps. */
+	check_units("  e   t  ", (const uint8_t[]){ 1, 7, 3, 7 }, 4);
+	check_units("e ", (const uint8_t[]){ 1, 7 }, 2);
+}
+
+ZTEST(morse_encode, test_encode_skips_unknown)
+{
+	check_units("e#t", (const uint8_t[]){ 1, 3, 3, 7 }, 4);
+	check_units("~e~", (const uint8_t[]){ 1, 7 }, 2);
+}
+
+ZTEST(morse_encode, test_encode_paris_is_50_units)
+{
+	uint8_t units[64];
+	uint32_t total = 0;
+
+	int n = morse_encode_units("PARIS", units, sizeof(units));
+	zassert_true(n > 0);
+	for (int i = 0; i < n; i++) {
+		total += units[i];
+	}
+	zassert_equal(total, 50U, "the standard word is 50 units, got %u", total);
+}
+
+ZTEST(morse_encode, test_encode_nothing_to_send)
+{
+	uint8_t units[8];
+
+	zassert_equal(morse_encode_units("", units, sizeof(units)), -EINVAL);
+	zassert_equal(morse_encode_units("   ", units, sizeof(units)), -EINVAL);
+	zassert_equal(morse_encode_units("#%~", units, sizeof(units)), -EINVAL);
+}
+
+ZTEST(morse_encode, test_encode_max_units)
+{
+	uint8_t units[16];
+
+	/* Exactly enough room works... */
+	zassert_equal(morse_encode_units("e", units, 2), 2);
+	zassert_equal(morse_encode_units("et", units, 4), 4);
+	zassert_equal(morse_encode_units("0", units, 10), 10);
+
+	/* ... one entry less does not, and nothing is written past max_units. */
+	static const struct {
+		const char* text;
+		size_t max_units;
+	} too_small[] = { { "e", 0 }, { "e", 1 }, { "et", 3 }, { "0", 9 }, { "e e", 3 } };
+
+	for (size_t i = 0; i < ARRAY_SIZE(too_small); i++) {
+		memset(units, 0xAA, sizeof(units));
+		zassert_equal(morse_encode_units(too_small[i].text, units, too_small[i].max_units), -ENOMEM,
+		              "\"%s\" fits in %u", too_small[i].text, (unsigned)too_small[i].max_units);
+		for (size_t j = too_small[i].max_units; j < sizeof(units); j++) {
+			zassert_equal(units[j], 0xAA, "\"%s\": units[%u] written", too_small[i].text, (unsigned)j);
+		}
+	}
+}
+
+/* --- MORSE_TIMELINE(): the same timeline at build time --- */
+
+MORSE_TIMELINE_DEFINE(tl_paris, P, A, R, I, S);
+MORSE_TIMELINE_DEFINE(tl_signs, C, Q, SLASH, AR, SK, DOLLAR);
+
+ZTEST(morse_encode, test_timeline_matches_runtime)
+{
+	check_units("paris", tl_paris, ARRAY_SIZE(tl_paris));
+	check_units("cq/+\x04$", tl_signs, ARRAY_SIZE(tl_signs));  // punctuation and prosigns too
+	zassert_equal(MORSE_TIMELINE_UNITS(P, A, R, I, S), 50);
+	zassert_equal(MORSE_PACK(G), morse_lookup('G'));
+}
+
+/* --- morse_speed_set(): WPM and Farnsworth timing --- */
+
+/* Time to send "PARIS " once, in us. */
+static uint32_t paris_us(const struct morse_speed* sp)
+{
+	uint8_t units[64];
+	uint32_t us = 0;
+
+	int n = morse_encode_units("PARIS", units, sizeof(units));
+	zassert_true(n > 0);
+	for (int i = 0; i < n; i += 2) {
+		us += morse_speed_on_us(sp, units[i]) + morse_speed_off_us(sp, units[i + 1]);
+	}
+	return us;
+}
+
+ZTEST(morse_encode, test_speed_paris_at_20_wpm)
+{
+	struct morse_speed sp;
+
+	zassert_ok(morse_speed_set(&sp, 20, 0));
+	zassert_equal(sp.unit_us, 60000U, "T at 20 WPM should be 60 ms");
+	zassert_equal(sp.letter_gap_us, 3U * 60000U);
+	zassert_equal(sp.word_gap_us, 7U * 60000U);
+	zassert_equal(paris_us(&sp), 3000000U, "20 words a minute");
+}
+
+ZTEST(morse_encode, test_speed_farnsworth)
+{
+	struct morse_speed sp;
+
+	/* Letters at 18 WPM, gaps stretched to 5 WPM overall: gap unit = (12 s - 31 T) / 19. */
+	zassert_ok(morse_speed_set(&sp, 18, 5));
+	zassert_equal(sp.unit_us, 66666U);
+	zassert_equal(sp.letter_gap_us, 3U * 522808U);
+	zassert_equal(sp.word_gap_us, 7U * 522808U);
+	zassert_within(paris_us(&sp), 12000000U, 100U, "5 words a minute, got %u us", paris_us(&sp));
+
+	/* The gaps inside a letter are not stretched. */
+	zassert_equal(morse_speed_off_us(&sp, MORSE_SYMBOL_GAP_UNITS), 66666U);
+	zassert_equal(morse_speed_plain_us(&sp, MORSE_WORD_GAP_UNITS), 7U * 66666U, "plain timing stretched");
+}
+
+ZTEST(morse_encode, test_speed_farnsworth_not_slower)
+{
+	struct morse_speed sp;
+	static const uint32_t fwpm[] = { 0, 20, 25 };
+
+	/* An overall speed that is not below the character speed changes nothing. */
+	for (size_t i = 0; i < ARRAY_SIZE(fwpm); i++) {
+		zassert_ok(morse_speed_set(&sp, 20, fwpm[i]));
+		zassert_equal(sp.letter_gap_us, 3U * sp.unit_us, "fwpm %u", fwpm[i]);
+		zassert_equal(sp.word_gap_us, 7U * sp.unit_us, "fwpm %u", fwpm[i]);
+	}
+}
+
+ZTEST(morse_encode, test_speed_invalid)
+{
+	struct morse_speed sp = { .unit_us = 1234U };
+
+	zassert_equal(morse_speed_set(&sp, 0, 0), -EINVAL);
+	zassert_equal(morse_speed_set(&sp, 0, 5), -EINVAL);
+	zassert_equal(morse_speed_set(&sp, 1200001U, 0), -EINVAL, "T under 1 us");
+	zassert_equal(sp.unit_us, 1234U, "a rejected speed changed the timing");
+
+	zassert_ok(morse_speed_set(&sp, 1200000U, 0));
+	zassert_equal(sp.unit_us, 1U);
+}
+
+ZTEST_SUITE(morse_encode, NULL, NULL, NULL, NULL, NULL);
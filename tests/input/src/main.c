@@ -0,0 +1,477 @@
+/*
+ * Input tests (native_sim): the lock-free update queue (morse_queue.h) on its
+ * own, then the two ways in of morse_input.h, both feeding one queue that the
+ * test pops like main() would:
+ *
+ *   1) "morse set", run through the dummy shell backend;
+ *   2) binary frames pushed into the emulated UART (geoffcha,morse-uart in
+ *      boards/native_sim.overlay) with uart_emul_put_rx_data(), the answers
+ *      (ACK/NAK) read back with uart_emul_get_tx_data().
+ *
+ * Whatever is rejected must leave the queue empty. Whatever is accepted must
+ * come out as a whole batch: its updates in a row, `last` set on the final
+ * one only.
+ */
+
+#include <stdio.h>                // snprintf()
+#include <string.h>               // memcpy(), memset(), strcpy()
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>        // k_timer, k_busy_wait()
+#include <zephyr/devicetree.h>    // DT_CHOSEN()
+#include <zephyr/drivers/serial/uart_emul.h>  // uart_emul_put_rx_data(), uart_emul_get_tx_data()
+#include <zephyr/shell/shell_dummy.h>         // shell_backend_dummy_get_ptr()
+#include <zephyr/sys/util.h>      // ARRAY_SIZE, WAIT_FOR()
+#include <morse_queue.h>          // (under test)
+#include <morse_input.h>          // (under test)
+
+#define NUM_CHANS 4
+
+/* What one popped update should be. */
+struct want {
+	uint8_t chan;
+	const char* text;
+	uint8_t last;
+};
+
+/* Pop everything and compare it with want[0..n-1]. */
+static void expect_queue(struct morse_queue* q, const struct want* want, size_t n)
+{
+	struct morse_update upd;
+	size_t got = 0;
+
+	while (morse_queue_pop(q, &upd)) {
+		zassert_true(got < n, "more than %u updates queued", (unsigned)n);
+		zassert_equal(upd.chan, want[got].chan, "update %u: LED%u", (unsigned)got, upd.chan);
+		zassert_str_equal(upd.text, want[got].text, "update %u: \"%s\"", (unsigned)got, upd.text);
+		zassert_equal(upd.last, want[got].last, "update %u: last = %u", (unsigned)got, upd.last);
+		got++;
+	}
+	zassert_equal(got, n, "%u updates queued, want %u", (unsigned)got, (unsigned)n);
+}
+
+static void expect_empty(struct morse_queue* q)
+{
+	expect_queue(q, NULL, 0);
+}
+
+/* count updates on chan, with texts "0", "1", ... */
+static void fill_batch(struct morse_update* upds, size_t count, uint8_t chan)
+{
+	for (size_t i = 0; i < count; i++) {
+		upds[i].chan = chan;
+		snprintf(upds[i].text, sizeof(upds[i].text), "%u", (unsigned)i);
+	}
+}
+
+/* ===================== morse_queue.h on its own ===================== */
+
+static struct morse_queue ring;
+
+static void queue_before(void* fixture)
+{
+	ARG_UNUSED(fixture);
+	morse_queue_init(&ring);
+}
+
+ZTEST(morse_queue, test_batches_come_out_whole)
+{
+	struct morse_update upds[3];
+
+	fill_batch(upds, 3, 2);
+	zassert_ok(morse_queue_push(&ring, upds, 3));
+	fill_batch(upds, 1, 0);
+	zassert_ok(morse_queue_push(&ring, upds, 1));
+
+	static const struct want want[] = { { 2, "0", 0 }, { 2, "1", 0 }, { 2, "2", 1 }, { 0, "0", 1 } };
+	expect_queue(&ring, want, ARRAY_SIZE(want));
+}
+
+ZTEST(morse_queue, test_batch_size_limits)
+{
+	struct morse_update upds[MORSE_QUEUE_LEN + 1];
+
+	fill_batch(upds, ARRAY_SIZE(upds), 0);
+	zassert_equal(morse_queue_push(&ring, upds, 0), -EINVAL);
+	zassert_equal(morse_queue_push(&ring, upds, MORSE_QUEUE_LEN + 1), -EINVAL);
+	expect_empty(&ring);
+
+	zassert_ok(morse_queue_push(&ring, upds, MORSE_QUEUE_LEN));
+	zassert_equal(morse_queue_pop(&ring, &upds[0]), true);
+}
+
+ZTEST(morse_queue, test_full_queue_takes_no_part_of_a_batch)
+{
+	struct morse_update upds[MORSE_QUEUE_LEN];
+	struct morse_update upd;
+
+	fill_batch(upds, MORSE_QUEUE_LEN, 1);
+	zassert_ok(morse_queue_push(&ring, upds, MORSE_QUEUE_LEN - 1));
+	zassert_equal(morse_queue_push(&ring, upds, 2), -ENOMEM, "only 1 slot is free");
+	zassert_ok(morse_queue_push(&ring, upds, 1));
+	zassert_equal(morse_queue_push(&ring, upds, 1), -ENOMEM, "no slot is free");
+
+	/* Freeing one slot makes room for one update, not two. */
+	zassert_true(morse_queue_pop(&ring, &upd));
+	zassert_equal(morse_queue_push(&ring, upds, 2), -ENOMEM);
+
+	size_t n = 1;
+	while (morse_queue_pop(&ring, &upd)) {
+		n++;
+	}
+	zassert_equal(n, MORSE_QUEUE_LEN, "%u updates came out", (unsigned)n);
+}
+
+/* Batches of 1..7 for many laps, so batches start and end all over the ring. */
+ZTEST(morse_queue, test_many_laps)
+{
+	struct morse_update upds[7];
+	struct morse_update upd;
+
+	for (uint32_t round = 0; round < 50 * MORSE_QUEUE_LEN; round++) {
+		size_t count = round % ARRAY_SIZE(upds) + 1;
+
+		fill_batch(upds, count, (uint8_t)(round % NUM_CHANS));
+		zassert_ok(morse_queue_push(&ring, upds, count), "round %u", round);
+		for (size_t i = 0; i < count; i++) {
+			char text[4];
+
+			snprintf(text, sizeof(text), "%u", (unsigned)i);
+			zassert_true(morse_queue_pop(&ring, &upd), "round %u: update %u missing", round, (unsigned)i);
+			zassert_equal(upd.chan, round % NUM_CHANS);
+			zassert_str_equal(upd.text, text);
+			zassert_equal(upd.last, i + 1 == count, "round %u: update %u", round, (unsigned)i);
+		}
+		zassert_false(morse_queue_pop(&ring, &upd), "round %u: too many updates", round);
+	}
+}
+
+/*
+ * A timer interrupt pushes batches of 3 (LED1) while the test thread pushes
+ * batches of 2 (LED0) and pops. native_sim only takes the interrupt during
+ * the busy wait, so this checks the batches around many wraps of the ring,
+ * not a race inside one push.
+ */
+#define ISR_BATCH 3
+#define THREAD_BATCH 2
+
+static struct k_timer isr_timer;
+static uint32_t isr_pushed;
+
+static void isr_push(struct k_timer* timer)
+{
+	struct morse_update upds[ISR_BATCH];
+
+	ARG_UNUSED(timer);
+	fill_batch(upds, ISR_BATCH, 1);
+	if (morse_queue_push(&ring, upds, ISR_BATCH) == 0) {
+		isr_pushed++;
+	}
+}
+
+ZTEST(morse_queue, test_interrupt_and_thread_producers)
+{
+	struct morse_update upds[THREAD_BATCH];
+	struct morse_update upd;
+	uint32_t thread_pushed = 0;
+	uint32_t popped[2] = { 0, 0 };  // whole batches per LED
+	size_t pos = 0;                 // position in the batch being popped
+	uint8_t chan = 0;
+
+	isr_pushed = 0;
+	k_timer_init(&isr_timer, isr_push, NULL);
+	k_timer_start(&isr_timer, K_USEC(300), K_USEC(300));
+
+	for (int round = 0; round < 500; round++) {
+		fill_batch(upds, THREAD_BATCH, 0);
+		if (morse_queue_push(&ring, upds, THREAD_BATCH) == 0) {
+			thread_pushed++;
+		}
+		k_busy_wait(700);
+
+		while (morse_queue_pop(&ring, &upd)) {
+			char text[4];
+
+			if (pos == 0) {
+				chan = upd.chan;
+			}
+			size_t size = (chan == 0) ? THREAD_BATCH : ISR_BATCH;
+
+			snprintf(text, sizeof(text), "%u", (unsigned)pos);
+			zassert_equal(upd.chan, chan, "LED%u update inside an LED%u batch", upd.chan, chan);
+			zassert_str_equal(upd.text, text, "LED%u batch: \"%s\" at %u", chan, upd.text, (unsigned)pos);
+			zassert_equal(upd.last, pos + 1 == size, "LED%u batch: last = %u at %u", chan, upd.last,
+			              (unsigned)pos);
+			pos = (pos + 1 == size) ? 0 : pos + 1;
+			if (pos == 0) {
+				popped[chan]++;
+			}
+		}
+	}
+	k_timer_stop(&isr_timer);
+
+	TC_PRINT("%u thread batches, %u interrupt batches\n", thread_pushed, isr_pushed);
+	zassert_equal(pos, 0U, "a batch was cut short");
+	zassert_true(isr_pushed > 0U, "the timer never pushed");
+	zassert_equal(popped[0], thread_pushed);
+	zassert_equal(popped[1], isr_pushed);
+}
+
+ZTEST_SUITE(morse_queue, NULL, NULL, queue_before, NULL, NULL);
+
+/* ===================== morse_input.h: shell and UART ===================== */
+
+static struct morse_queue input_q;
+K_SEM_DEFINE(input_sem, 0, 1);
+
+static const struct device* const uart = DEVICE_DT_GET(DT_CHOSEN(geoffcha_morse_uart));
+static const struct shell* sh;
+
+/* A UART frame, built up by frame_start(), frame_add() and frame_end(). */
+struct frame {
+	uint8_t bytes[200];
+	size_t len;
+};
+
+static void frame_start(struct frame* f, uint8_t count)
+{
+	f->bytes[0] = MORSE_UART_START;
+	f->bytes[1] = count;
+	f->len = 2;
+}
+
+/* len is sent as it is, so it can lie about text. */
+static void frame_add(struct frame* f, uint8_t led, uint8_t len, const char* text)
+{
+	f->bytes[f->len++] = led;
+	f->bytes[f->len++] = len;
+	memcpy(&f->bytes[f->len], text, len);
+	f->len += len;
+}
+
+static void frame_end(struct frame* f)
+{
+	uint8_t sum = 0;
+
+	for (size_t i = 1; i < f->len; i++) {
+		sum += f->bytes[i];
+	}
+	f->bytes[f->len++] = sum;
+}
+
+/* Push bytes into the UART, give the interrupt time to run, return the answers. */
+static size_t uart_send(const uint8_t* bytes, size_t len, uint8_t* answers, size_t max)
+{
+	zassert_equal(uart_emul_put_rx_data(uart, bytes, len), len);
+	k_msleep(1);
+	return uart_emul_get_tx_data(uart, answers, max);
+}
+
+static void expect_answer(const struct frame* f, uint8_t want)
+{
+	uint8_t answers[4];
+	size_t n = uart_send(f->bytes, f->len, answers, sizeof(answers));
+
+	zassert_equal(n, 1, "%u answers to one frame", (unsigned)n);
+	zassert_equal(answers[0], want, "answer 0x%02x, want 0x%02x", answers[0], want);
+}
+
+static void* input_setup(void)
+{
+	sh = shell_backend_dummy_get_ptr();
+	zassert_true(WAIT_FOR(shell_ready(sh), 1000000, k_msleep(1)), "shell not ready");
+
+	morse_queue_init(&input_q);
+	zassert_ok(morse_input_init(&input_q, &input_sem, NUM_CHANS));
+	return NULL;
+}
+
+static void input_before(void* fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Long enough for a frame a previous test left half done to time out. */
+	k_msleep(2);
+	uart_emul_flush_rx_data(uart);
+	uart_emul_flush_tx_data(uart);
+	k_sem_reset(&input_sem);
+
+	struct morse_update upd;
+	while (morse_queue_pop(&input_q, &upd)) {
+	}
+}
+
+/* --- morse set --- */
+
+ZTEST(morse_input, test_set_is_one_batch)
+{
+	zassert_ok(shell_execute_cmd(sh, "morse set 0 sos 3 \"cq de k\""));
+	zassert_ok(k_sem_take(&input_sem, K_NO_WAIT), "consumer not woken");
+
+	static const struct want want[] = { { 0, "sos", 0 }, { 3, "cq de k", 1 } };
+	expect_queue(&input_q, want, ARRAY_SIZE(want));
+}
+
+ZTEST(morse_input, test_set_rejects)
+{
+	static const char* const bad[] = {
+		"morse set 4 sos",       // no LED4
+		"morse set x sos",
+		"morse set 0 sos 1",     // text missing
+		"morse set 0 sos 9 cq",  // one bad pair spoils the batch
+	};
+	char too_long[sizeof("morse set 0 ") + MORSE_MSG_MAX + 1];
+
+	for (size_t i = 0; i < ARRAY_SIZE(bad); i++) {
+		zassert_not_equal(shell_execute_cmd(sh, bad[i]), 0, "\"%s\" accepted", bad[i]);
+	}
+
+	/* MORSE_MSG_MAX + 1 characters */
+	strcpy(too_long, "morse set 0 ");
+	memset(&too_long[strlen(too_long)], 'e', MORSE_MSG_MAX + 1);
+	too_long[sizeof(too_long) - 1] = '\0';
+	zassert_not_equal(shell_execute_cmd(sh, too_long), 0, "%u characters accepted", MORSE_MSG_MAX + 1);
+	zassert_equal(k_sem_take(&input_sem, K_NO_WAIT), -EBUSY, "consumer woken");
+	expect_empty(&input_q);
+}
+
+/* --- UART frames --- */
+
+ZTEST(morse_input, test_uart_good_batch)
+{
+	struct frame f;
+
+	frame_start(&f, 3);
+	frame_add(&f, 0, 5, "geoff");
+	frame_add(&f, 2, 3, "cha");
+	frame_add(&f, 3, 7, "is dumb");
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_ACK);
+	zassert_ok(k_sem_take(&input_sem, K_NO_WAIT), "consumer not woken");
+
+	static const struct want want[] = { { 0, "geoff", 0 }, { 2, "cha", 0 }, { 3, "is dumb", 1 } };
+	expect_queue(&input_q, want, ARRAY_SIZE(want));
+}
+
+ZTEST(morse_input, test_uart_bad_checksum)
+{
+	struct frame f;
+
+	frame_start(&f, 1);
+	frame_add(&f, 0, 3, "sos");
+	frame_end(&f);
+	f.bytes[f.len - 1] ^= 0x01;
+	expect_answer(&f, MORSE_UART_NAK);
+	expect_empty(&input_q);
+}
+
+ZTEST(morse_input, test_uart_bad_count)
+{
+	static const uint8_t counts[] = { 0, MORSE_INPUT_MAX_BATCH + 1 };
+	struct frame f;
+
+	for (size_t i = 0; i < ARRAY_SIZE(counts); i++) {
+		frame_start(&f, counts[i]);
+		frame_add(&f, 0, 3, "sos");
+		frame_end(&f);
+		expect_answer(&f, MORSE_UART_NAK);
+		k_msleep(2);  // the NAK came early; let the rest of the frame time out
+	}
+	expect_empty(&input_q);
+}
+
+ZTEST(morse_input, test_uart_bad_led)
+{
+	struct frame f;
+
+	frame_start(&f, 2);
+	frame_add(&f, 0, 3, "sos");
+	frame_add(&f, NUM_CHANS, 3, "sos");
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_NAK);
+	expect_empty(&input_q);
+}
+
+ZTEST(morse_input, test_uart_bad_len)
+{
+	static char long_text[MORSE_MSG_MAX + 1];
+	struct frame f;
+
+	memset(long_text, 'e', sizeof(long_text));
+
+	frame_start(&f, 1);
+	frame_add(&f, 0, 0, "");
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_NAK);
+	k_msleep(2);
+
+	frame_start(&f, 1);
+	frame_add(&f, 0, MORSE_MSG_MAX + 1, long_text);
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_NAK);
+	expect_empty(&input_q);
+}
+
+ZTEST(morse_input, test_uart_full_queue)
+{
+	static const char* const texts[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+	struct frame f;
+
+	/* 8 + 6 updates leave 2 of the 16 slots free... */
+	frame_start(&f, 8);
+	for (size_t i = 0; i < 8; i++) {
+		frame_add(&f, i % NUM_CHANS, 1, texts[i]);
+	}
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_ACK);
+
+	frame_start(&f, 6);
+	for (size_t i = 0; i < 6; i++) {
+		frame_add(&f, 1, 1, texts[i]);
+	}
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_ACK);
+
+	/* ... so a batch of 3 is refused as a whole. */
+	frame_start(&f, 3);
+	for (size_t i = 0; i < 3; i++) {
+		frame_add(&f, 2, 1, "x");
+	}
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_NAK);
+
+	BUILD_ASSERT(MORSE_QUEUE_LEN == 16, "adjust the batch sizes above");
+	static const struct want want[] = {
+		{ 0, "a", 0 }, { 1, "b", 0 }, { 2, "c", 0 }, { 3, "d", 0 },
+		{ 0, "e", 0 }, { 1, "f", 0 }, { 2, "g", 0 }, { 3, "h", 1 },
+		{ 1, "a", 0 }, { 1, "b", 0 }, { 1, "c", 0 }, { 1, "d", 0 }, { 1, "e", 0 }, { 1, "f", 1 },
+	};
+	expect_queue(&input_q, want, ARRAY_SIZE(want));
+}
+
+ZTEST(morse_input, test_uart_lost_byte_costs_one_frame)
+{
+	uint8_t answers[4];
+	struct frame lost;
+	struct frame f;
+
+	/* A frame whose last text byte and checksum never arrive... */
+	frame_start(&lost, 1);
+	frame_add(&lost, 0, 3, "sos");
+	frame_end(&lost);
+	zassert_equal(uart_send(lost.bytes, lost.len - 2, answers, sizeof(answers)), 0,
+	              "answer to half a frame");
+
+	/* ... goes quiet for longer than MORSE_UART_IDLE_BYTES byte times... */
+	k_busy_wait(2 * MORSE_UART_IDLE_US);
+
+	/* ... and the next frame is received as a frame, not as the missing text. */
+	frame_start(&f, 1);
+	frame_add(&f, 1, 2, "cq");
+	frame_end(&f);
+	expect_answer(&f, MORSE_UART_ACK);
+
+	static const struct want want[] = { { 1, "cq", 1 } };
+	expect_queue(&input_q, want, ARRAY_SIZE(want));
+}
+
+ZTEST_SUITE(morse_input, NULL, input_setup, input_before, NULL, NULL);
@@ -0,0 +1,347 @@
+/*
+ * Loopback tests (native_sim): the four LEDs are wired back to four input
+ * lines (zephyr,user loop-rx-gpios) and what they send is decoded again.
+ *
+ *   morse_stripe  ONE message dealt out letter by letter over 1, 2 and 4
+ *                 LEDs (morse_stripe.h), with the characters per second of
+ *                 each width against single-LED Morse.
+ *   morse_line    the same text at the same T as Morse, as an NRZ frame and
+ *                 as a Manchester frame (morse_line.h), one LED each, with
+ *                 the payload bits per second of each.
+ *
+ * Both use the loopback fixture below: the one-timer scheduler
+ * (morse_sched.h) plays one bitstream per LED, all starting on the same tick,
+ * which is the shared clock. The emulated GPIO has no wires, so a sampler
+ * timer copies every LED to its input line (gpio_emul_input_set()) and then
+ * calls the test's receivers, in the middle of every unit.
+ *
+ * Simulated time runs as fast as it can (prj.conf).
+ */
+
+#include <ctype.h>                // toupper()
+#include <string.h>               // strcmp(), memcmp()
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>        // k_timer
+#include <zephyr/devicetree.h>    // DT_PATH()
+#include <zephyr/drivers/gpio.h>  // GPIO types for LEDs
+#include <zephyr/drivers/gpio/gpio_emul.h>  // gpio_emul_output_get(), gpio_emul_input_set()
+#include <zephyr/sys/util.h>      // ARRAY_SIZE, MAX
+#include <leds_funcs.h>           // setup_leds(), set_leds()
+#include <morse_sched.h>          // one timer plays every LED
+#include <morse_bits.h>           // morse_bits_encode()
+#include <morse_stripe.h>         // (under test)
+#include <morse_line.h>           // (under test)
+
+#define T_MS 10
+
+#define NUM_LEDS 4
+
+#define USER_NODE DT_PATH(zephyr_user)
+
+/* --- Fixture: LEDs wired back to inputs, played by one scheduler, sampled mid-unit --- */
+
+static const struct gpio_dt_spec gds_leds[NUM_LEDS] = {
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led0), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led1), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led2), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led3), gpios),
+};
+
+static const struct gpio_dt_spec* p_gds_leds[NUM_LEDS] = {
+	&gds_leds[0], &gds_leds[1], &gds_leds[2], &gds_leds[3]
+};
+
+static const struct gpio_dt_spec rx_pins[NUM_LEDS] = {
+	GPIO_DT_SPEC_GET_BY_IDX(USER_NODE, loop_rx_gpios, 0),
+	GPIO_DT_SPEC_GET_BY_IDX(USER_NODE, loop_rx_gpios, 1),
+	GPIO_DT_SPEC_GET_BY_IDX(USER_NODE, loop_rx_gpios, 2),
+	GPIO_DT_SPEC_GET_BY_IDX(USER_NODE, loop_rx_gpios, 3),
+};
+
+/* Big enough for the longest message below in Morse on one LED. */
+#define LOOP_MAX_TEXT 64
+#define LOOP_BYTES MORSE_BITS_BYTES(MORSE_BITS_MAX_PER_CHAR * LOOP_MAX_TEXT)
+
+static uint8_t loop_bits[NUM_LEDS][LOOP_BYTES];
+static uint8_t* const p_loop_bits[NUM_LEDS] = {
+	loop_bits[0], loop_bits[1], loop_bits[2], loop_bits[3]
+};
+
+struct loopback {
+	struct morse_bits_reader msgs[NUM_LEDS];
+	struct morse_chan chans[NUM_LEDS];
+	struct morse_sched sched;
+	struct k_timer sampler;
+	size_t num_leds;
+	void (*sample)(void);  // the test's receivers, after the wires are copied
+	int64_t start;         // tick the first unit began
+};
+
+static struct loopback loop;
+
+static void loop_sample_expiry(struct k_timer* timer)
+{
+	ARG_UNUSED(timer);
+
+	for (size_t idx = 0; idx < loop.num_leds; idx++) {
+		gpio_emul_input_set(rx_pins[idx].port, rx_pins[idx].pin,
+		                    gpio_emul_output_get(gds_leds[idx].port, gds_leds[idx].pin));
+	}
+	loop.sample();
+}
+
+/* Play loop_bits[0..num_leds) (nbits[] each) from the same tick, sampling every unit. */
+static void loop_start(const int nbits[], size_t num_leds, void (*sample)(void))
+{
+	set_leds(p_gds_leds, NUM_LEDS, false);
+	for (size_t idx = 0; idx < num_leds; idx++) {
+		zassert_true(nbits[idx] > 0, "LED%u: nothing encoded (%d)", (unsigned)idx, nbits[idx]);
+		morse_bits_reader_init(&loop.msgs[idx], loop_bits[idx], (size_t)nbits[idx], NULL, NULL);
+		loop.chans[idx] = (struct morse_chan){ .led = &gds_leds[idx], .bits = &loop.msgs[idx] };
+	}
+	loop.num_leds = num_leds;
+	loop.sample = sample;
+	zassert_ok(morse_sched_start(&loop.sched, loop.chans, num_leds, T_MS));
+
+	/* Every LED starts at chans[].next_edge; sample half a unit later, then every unit. */
+	loop.start = loop.chans[0].next_edge;
+	k_timer_init(&loop.sampler, loop_sample_expiry, NULL);
+	k_timer_start(&loop.sampler, K_TIMEOUT_ABS_TICKS(loop.start + loop.sched.unit_ticks / 2),
+	              K_TICKS(loop.sched.unit_ticks));
+}
+
+static void loop_stop(void)
+{
+	k_timer_stop(&loop.sampler);
+	morse_sched_stop(&loop.sched);
+}
+
+/* Milliseconds from the first unit to ticks (at least 1). */
+static uint32_t loop_ms(int64_t ticks)
+{
+	return (uint32_t)MAX(k_ticks_to_ms_near64(ticks - loop.start), 1);
+}
+
+/* What a Morse receiver gives back for text: upper case, ending with the word gap's ' '. */
+static void loop_expected(const char* text, char* out, size_t out_len)
+{
+	size_t n;
+
+	for (n = 0; text[n] != '\0' && n + 2 < out_len; n++) {
+		out[n] = (char)toupper((unsigned char)text[n]);
+	}
+	out[n++] = ' ';
+	out[n] = '\0';
+}
+
+static void* loop_suite_setup(void)
+{
+	zassert_ok(setup_leds(p_gds_leds, NUM_LEDS));
+	return NULL;
+}
+
+/* --- Striped transmission --- */
+
+/* Written already normalized (lower case, single spaces), so the decoded text is just its upper case. */
+#define STRIPE_MESSAGE "the quick brown fox jumps over the lazy dog 1234567890"
+BUILD_ASSERT(sizeof(STRIPE_MESSAGE) <= LOOP_MAX_TEXT);
+
+static struct morse_stripe_rx stripe_rx;
+static char stripe_expected[LOOP_MAX_TEXT + 1];
+static char stripe_text[sizeof(stripe_expected)];
+static size_t stripe_len;
+static int64_t stripe_done;
+K_SEM_DEFINE(stripe_sem, 0, 1);
+
+static void stripe_got_char(struct morse_stripe_rx* r, char c)
+{
+	ARG_UNUSED(r);
+
+	if (stripe_len + 1 < sizeof(stripe_text)) {
+		stripe_text[stripe_len++] = c;
+		stripe_text[stripe_len] = '\0';
+	}
+	if (stripe_len == strlen(stripe_expected)) {
+		stripe_done = k_uptime_ticks();  // the final word gap has just been seen
+		k_sem_give(&stripe_sem);
+	}
+}
+
+static void stripe_sample(void)
+{
+	morse_stripe_rx_sample(&stripe_rx);
+}
+
+/* Send STRIPE_MESSAGE once over width LEDs. Returns the time until it was decoded, in ms. */
+static uint32_t stripe_round(size_t width)
+{
+	int nbits[NUM_LEDS];
+
+	nbits[0] = morse_stripe_encode(STRIPE_MESSAGE, width, p_loop_bits, LOOP_BYTES);
+	for (size_t idx = 1; idx < width; idx++) {
+		nbits[idx] = nbits[0];  // every line is as long as the whole message
+	}
+
+	stripe_len = 0;
+	stripe_text[0] = '\0';
+	k_sem_reset(&stripe_sem);
+	zassert_ok(morse_stripe_rx_init(&stripe_rx, rx_pins, width, stripe_got_char));
+	loop_start(nbits, width, stripe_sample);
+
+	/* One pass takes nbits units; twice that and it is not coming. */
+	int ret = k_sem_take(&stripe_sem, K_MSEC(2 * nbits[0] * T_MS));
+	loop_stop();
+
+	zassert_ok(ret, "%u LED(s): timed out, got \"%s\"", (unsigned)width, stripe_text);
+	zassert_str_equal(stripe_text, stripe_expected, "%u LED(s)", (unsigned)width);
+	TC_PRINT("%u LED(s): %d units per LED\n", (unsigned)width, nbits[0]);
+	return loop_ms(stripe_done);
+}
+
+ZTEST(morse_stripe, test_decode_1_2_4_leds)
+{
+	static const size_t widths[] = { 1, 2, 4 };
+	uint32_t ms[ARRAY_SIZE(widths)];
+
+	loop_expected(STRIPE_MESSAGE, stripe_expected, sizeof(stripe_expected));
+
+	for (size_t w = 0; w < ARRAY_SIZE(widths); w++) {
+		ms[w] = stripe_round(widths[w]);
+
+		/* Characters per second and speed-up over one LED, with two decimals. */
+		uint32_t cps100 = (uint32_t)(strlen(STRIPE_MESSAGE) * 100000U / ms[w]);
+		uint32_t gain100 = ms[0] * 100U / ms[w];
+		TC_PRINT("%u LED(s): %u ms, %u.%02u chars/s, x%u.%02u\n", (unsigned)widths[w], ms[w],
+		         cps100 / 100U, cps100 % 100U, gain100 / 100U, gain100 % 100U);
+		if (w > 0) {
+			zassert_true(ms[w] < ms[w - 1], "%u LEDs are not faster than %u", (unsigned)widths[w],
+			             (unsigned)widths[w - 1]);
+		}
+	}
+}
+
+/* Striping over one LED is plain Morse. */
+ZTEST(morse_stripe, test_one_led_is_plain_morse)
+{
+	static uint8_t plain[LOOP_BYTES];
+	int nbits = morse_bits_encode(STRIPE_MESSAGE, plain, sizeof(plain));
+
+	zassert_equal(morse_stripe_encode(STRIPE_MESSAGE, 1, p_loop_bits, LOOP_BYTES), nbits);
+	zassert_mem_equal(loop_bits[0], plain, MORSE_BITS_BYTES(nbits));
+}
+
+ZTEST_SUITE(morse_stripe, NULL, loop_suite_setup, NULL, NULL, NULL);
+
+/* --- Line coding against Morse --- */
+
+/* Lower case with single spaces, so the Morse receiver gives back its upper case. */
+#define LINE_MESSAGE "the quick brown fox jumps over the lazy dog"
+BUILD_ASSERT(sizeof(LINE_MESSAGE) <= LOOP_MAX_TEXT);
+BUILD_ASSERT(MORSE_LINE_FRAME_UNITS(MORSE_LINE_MANCHESTER, sizeof(LINE_MESSAGE) - 1) <= LOOP_BYTES * 8U);
+
+#define LINE_CHANS 3
+
+/* What each LED sends: Morse, or one of the line codes. */
+#define MODE_MORSE (-1)
+static const int line_modes[LINE_CHANS] = { MODE_MORSE, MORSE_LINE_NRZ, MORSE_LINE_MANCHESTER };
+static const char* const line_mode_names[LINE_CHANS] = { "Morse", "NRZ", "Manchester" };
+
+static struct morse_stripe_rx line_morse_rx;     // a sampled Morse receiver (one line)
+static struct morse_line_rx line_rx[LINE_CHANS];  // [1] and [2] are used
+
+/* When each channel's message was first decoded (0 = not yet). */
+static int64_t line_done[LINE_CHANS];
+K_SEM_DEFINE(line_sem, 0, LINE_CHANS);
+
+static char line_expected[LOOP_MAX_TEXT + 1];
+static char line_morse_text[sizeof(line_expected)];
+static size_t line_morse_len;
+
+static void line_mark_done(size_t idx)
+{
+	if (line_done[idx] == 0) {
+		line_done[idx] = k_uptime_ticks();
+		k_sem_give(&line_sem);
+	}
+}
+
+static void line_got_char(struct morse_stripe_rx* r, char c)
+{
+	ARG_UNUSED(r);
+
+	if (line_morse_len + 1 < sizeof(line_morse_text)) {
+		line_morse_text[line_morse_len++] = c;
+		line_morse_text[line_morse_len] = '\0';
+	}
+	if (strcmp(line_morse_text, line_expected) == 0) {
+		line_mark_done(0);
+	}
+}
+
+static void line_got_frame(struct morse_line_rx* r, const uint8_t* data, size_t len)
+{
+	if (len == strlen(LINE_MESSAGE) && memcmp(data, LINE_MESSAGE, len) == 0) {
+		line_mark_done((size_t)(r - line_rx));
+	}
+}
+
+static void line_sample(void)
+{
+	for (size_t idx = 0; idx < LINE_CHANS; idx++) {
+		if (line_modes[idx] == MODE_MORSE) {
+			morse_stripe_rx_sample(&line_morse_rx);
+		} else {
+			morse_line_rx_sample(&line_rx[idx]);
+		}
+	}
+}
+
+ZTEST(morse_line, test_morse_nrz_manchester)
+{
+	int nbits[LINE_CHANS];
+	int longest = 0;
+
+	loop_expected(LINE_MESSAGE, line_expected, sizeof(line_expected));
+
+	/* Each LED encodes the message its own way, and gets a receiver to match. */
+	for (size_t idx = 0; idx < LINE_CHANS; idx++) {
+		if (line_modes[idx] == MODE_MORSE) {
+			nbits[idx] = morse_bits_encode(LINE_MESSAGE, loop_bits[idx], LOOP_BYTES);
+			zassert_ok(morse_stripe_rx_init(&line_morse_rx, &rx_pins[idx], 1, line_got_char));
+		} else {
+			nbits[idx] = morse_line_encode((enum morse_line_code)line_modes[idx], (const uint8_t*)LINE_MESSAGE,
+			                               strlen(LINE_MESSAGE), loop_bits[idx], LOOP_BYTES);
+			zassert_ok(morse_line_rx_init(&line_rx[idx], &rx_pins[idx], (enum morse_line_code)line_modes[idx],
+			                              line_got_frame));
+		}
+	}
+	loop_start(nbits, LINE_CHANS, line_sample);
+
+	/* Wait for all of them; twice the longest stream is plenty. */
+	for (size_t idx = 0; idx < LINE_CHANS; idx++) {
+		longest = MAX(longest, nbits[idx]);
+	}
+	for (size_t idx = 0; idx < LINE_CHANS; idx++) {
+		if (k_sem_take(&line_sem, K_MSEC(2 * longest * T_MS)) < 0) {
+			break;
+		}
+	}
+	loop_stop();
+
+	uint32_t morse_ms = (line_done[0] != 0) ? loop_ms(line_done[0]) : 0U;
+	for (size_t idx = 0; idx < LINE_CHANS; idx++) {
+		zassert_not_equal(line_done[idx], 0, "%s: not decoded", line_mode_names[idx]);
+
+		/* Payload bits per second and speed-up over Morse, with two decimals. */
+		uint32_t ms = loop_ms(line_done[idx]);
+		uint32_t bps100 = (uint32_t)(strlen(LINE_MESSAGE) * 8U * 100000U / ms);
+		uint32_t gain100 = morse_ms * 100U / ms;
+		TC_PRINT("%-10s %5d units, %5u ms, %u.%02u bit/s, x%u.%02u\n", line_mode_names[idx], nbits[idx], ms,
+		         bps100 / 100U, bps100 % 100U, gain100 / 100U, gain100 % 100U);
+	}
+	zassert_equal(line_rx[1].crc_errors, 0U, "NRZ: bad CRC");
+	zassert_equal(line_rx[2].crc_errors, 0U, "Manchester: bad CRC");
+	zassert_equal(line_rx[2].code_errors, 0U, "Manchester: bits without a mid-bit edge");
+}
+
+ZTEST_SUITE(morse_line, NULL, loop_suite_setup, NULL, NULL, NULL);
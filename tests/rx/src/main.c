@@ -0,0 +1,150 @@
+/*
+ * Receiver tests (native_sim): LED0 sends a message, the receiver
+ * (morse_rx.h) listens on an input pin looped back to it, and every round
+ * must decode to the message. The sender changes speed by 15% every round
+ * WITHOUT telling the receiver, which has to follow on its own.
+ *
+ * Pins come from the zephyr,user node of boards/native_sim.overlay:
+ *   morse-tx-gpios = LED that sends, morse-rx-gpios = input that listens.
+ * The emulated GPIO has no wires, so every TX write is copied to the RX pin
+ * with gpio_emul_input_set(), which fires the input interrupt like real
+ * hardware would.
+ */
+
+#include <ctype.h>                // toupper()
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>        // threads
+#include <zephyr/devicetree.h>    // DT_PATH()
+#include <zephyr/drivers/gpio.h>  // GPIO_DT_SPEC_GET()
+#include <zephyr/drivers/gpio/gpio_emul.h>  // gpio_emul_input_set()
+#include <zephyr/sys/util.h>      // DIV_ROUND_UP()
+#include <leds_funcs.h>           // setup_leds()
+#include <morse_bits.h>           // morse_bits_encode(), morse_bits_next_run()
+#include <morse_clock.h>          // absolute deadlines for the sender
+#include <morse_rx.h>             // (under test)
+
+#define MESSAGE "paris cq de k 73"
+
+/* Slowest and fastest unit T the sender uses, in ms (WPM = 1200 / T). */
+#define SLOW_T_MS 60
+#define FAST_T_MS 6
+
+/* First guess the receiver starts with (deliberately not the first speed). */
+#define RX_GUESS_MS 100
+
+#define RX_STACK_SIZE 1024
+#define RX_PRIORITY 2     // above the sender, so edges never pile up
+
+#define USER_NODE DT_PATH(zephyr_user)
+
+static const struct gpio_dt_spec tx_pin = GPIO_DT_SPEC_GET(USER_NODE, morse_tx_gpios);
+static const struct gpio_dt_spec rx_pin = GPIO_DT_SPEC_GET(USER_NODE, morse_rx_gpios);
+
+static struct morse_rx rx;
+
+/* What the receiver decoded in the current round. */
+static char rx_text[64];
+static size_t rx_len;
+
+static uint8_t msg_bits[32];
+static int msg_nbits;
+static char expected[sizeof(rx_text)];
+
+static void got_char(struct morse_rx* r, char c)
+{
+	ARG_UNUSED(r);
+
+	if (rx_len + 1 < sizeof(rx_text)) {
+		rx_text[rx_len++] = c;
+		rx_text[rx_len] = '\0';
+	}
+}
+
+K_KERNEL_STACK_DEFINE(rx_stack, RX_STACK_SIZE);
+static struct k_thread rx_thread;
+
+static void rx_entry(void* p1, void* p2, void* p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		morse_rx_process(&rx);
+	}
+}
+
+/* Drive the TX LED and the "wire" to the RX pin. */
+static void tx_set(bool on)
+{
+	gpio_pin_set_dt(&tx_pin, on);
+	gpio_emul_input_set(rx_pin.port, rx_pin.pin, on);
+}
+
+/* Send the message once at t_ms per unit and check what came back. */
+static void send_and_check(uint32_t t_ms)
+{
+	struct morse_bits_reader rd;
+	struct morse_clock clk;
+	uint32_t run;
+	bool on;
+
+	rx_len = 0;
+	rx_text[0] = '\0';
+
+	morse_bits_reader_init(&rd, msg_bits, (size_t)msg_nbits, NULL, NULL);
+	morse_clock_start(&clk, true);
+	while ((run = morse_bits_next_run(&rd, &on)) != 0U) {
+		morse_clock_edge(&clk);
+		tx_set(on);
+		morse_clock_wait(&clk, run * t_ms);
+	}
+
+	/* The message ends in a word gap; give the receiver time to notice it. */
+	k_msleep(MORSE_WORD_GAP_UNITS * t_ms);
+
+	TC_PRINT("%3u WPM (T = %2u ms): \"%s\", unit guess %u us\n", 1200U / t_ms, t_ms, rx_text,
+	         k_cyc_to_us_near32(rx.unit));
+	zassert_str_equal(rx_text, expected, "%u WPM: \"%s\"", 1200U / t_ms, rx_text);
+	zassert_equal(rx.overruns, 0U, "%u WPM: edges dropped", 1200U / t_ms);
+}
+
+static void* rx_suite_setup(void)
+{
+	const struct gpio_dt_spec* p_tx[] = { &tx_pin };
+
+	zassert_ok(setup_leds(p_tx, 1));
+	zassert_ok(morse_rx_init(&rx, &rx_pin, RX_GUESS_MS, got_char));
+	k_thread_create(&rx_thread, rx_stack, K_KERNEL_STACK_SIZEOF(rx_stack), rx_entry,
+	                NULL, NULL, NULL, RX_PRIORITY, 0, K_NO_WAIT);
+
+	msg_nbits = morse_bits_encode(MESSAGE, msg_bits, sizeof(msg_bits));
+	zassert_true(msg_nbits > 0);
+
+	/* The receiver answers in upper case and ends the word gap with ' '. */
+	size_t n;
+	for (n = 0; MESSAGE[n] != '\0'; n++) {
+		expected[n] = (char)toupper((unsigned char)MESSAGE[n]);
+	}
+	expected[n++] = ' ';
+	expected[n] = '\0';
+	return NULL;
+}
+
+/* 20 WPM up to 200 WPM, 15% faster every round. */
+ZTEST(morse_rx, test_sender_speeds_up)
+{
+	for (uint32_t t_ms = SLOW_T_MS; t_ms >= FAST_T_MS; t_ms = t_ms * 85U / 100U) {
+		send_and_check(t_ms);
+	}
+}
+
+/* 200 WPM down to 20 WPM, 15% slower every round. */
+ZTEST(morse_rx, test_sender_slows_down)
+{
+	for (uint32_t t_ms = FAST_T_MS; t_ms <= SLOW_T_MS; t_ms = DIV_ROUND_UP(t_ms * 115U, 100U)) {
+		send_and_check(t_ms);
+	}
+}
+
+ZTEST_SUITE(morse_rx, NULL, rx_suite_setup, NULL, NULL, NULL);
@@ -0,0 +1,229 @@
+/*
+ * Message store tests (native_sim): inc/morse_store.h on native_sim's storage
+ * partition (geoffcha,morse-store in boards/native_sim.overlay), on the flash
+ * simulator. Every test starts from an erased partition.
+ *
+ * morse_store_init() stands in for a reboot: records added or erased after
+ * it only show up at the next one. What a channel plays is checked run by run
+ * against morse_bits_encode() of the texts it was given, in the order added,
+ * twice round.
+ *
+ * A write cut short by a reset is made by hand: bits with no header, or a
+ * header that stops half way (the rest still 0xFF).
+ */
+
+#include <stddef.h>                     // offsetof()
+#include <string.h>                     // memcpy(), memset()
+#include <zephyr/ztest.h>
+#include <zephyr/storage/flash_map.h>   // flash_area_erase(), flash_area_write()
+#include <morse_bits.h>                 // morse_bits_encode(), morse_bits_next_run()
+#include <morse_store.h>                // (under test)
+
+static struct morse_store store;
+
+/* Check that chan plays texts[0..n-1] one after the other, then starts over. */
+static void expect_plays(uint8_t chan, const char* const* texts, size_t n)
+{
+	static uint8_t bits[MORSE_STORE_MAX_BYTES];
+	struct morse_store_cursor cur;
+	struct morse_bits_reader rd;
+	struct morse_bits_reader want;
+	bool on;
+	bool want_on;
+	uint32_t units;
+
+	zassert_true(morse_store_reader(&store, &cur, chan, &rd), "chan %u has nothing", chan);
+	for (int lap = 0; lap < 2; lap++) {
+		for (size_t i = 0; i < n; i++) {
+			int nbits = morse_bits_encode(texts[i], bits, sizeof(bits));
+
+			zassert_true(nbits > 0);
+			morse_bits_reader_init(&want, bits, (size_t)nbits, NULL, NULL);
+			while ((units = morse_bits_next_run(&want, &want_on)) != 0U) {
+				zassert_equal(morse_bits_next_run(&rd, &on), units, "chan %u lap %d \"%s\": run length",
+				              chan, lap, texts[i]);
+				zassert_equal(on, want_on, "chan %u lap %d \"%s\": level", chan, lap, texts[i]);
+			}
+		}
+		zassert_equal(morse_bits_next_run(&rd, &on), 0U, "chan %u plays more than it was given", chan);
+		morse_bits_rewind(&rd);
+	}
+}
+
+/* Write what a reset in the middle of adding text to chan would leave behind. */
+static void cut_short(uint8_t chan, const char* text, bool with_half_header)
+{
+	static uint8_t bits[MORSE_STORE_MAX_BYTES];
+	struct morse_store_rec rec = { .magic = MORSE_STORE_MAGIC, .chan = chan, .reserved = 0 };
+	uint8_t hdr[MORSE_STORE_HDR_SIZE];
+	int nbits = morse_bits_encode(text, bits, sizeof(bits));
+
+	zassert_true(nbits > 0);
+	zassert_ok(flash_area_write(store.fa, store.end + MORSE_STORE_HDR_SIZE, bits,
+	                            ROUND_UP(MORSE_BITS_BYTES((size_t)nbits), MORSE_STORE_ALIGN)));
+	if (with_half_header) {
+		/* Magic, chan and reserved made it; nbits is still erased. */
+		memset(hdr, 0xFF, sizeof(hdr));
+		memcpy(hdr, &rec, offsetof(struct morse_store_rec, nbits));
+		zassert_ok(flash_area_write(store.fa, store.end, hdr, sizeof(hdr)));
+	}
+}
+
+/* After a write was cut short: adding fails, erasing works, and the next boot starts clean. */
+static void expect_recovery(uint32_t count)
+{
+	static const char* const is[] = { "is" };
+
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, count, "records before the damage are lost");
+	zassert_true(store.damaged);
+	zassert_equal(morse_store_add(&store, 0, "is"), -EIO);
+
+	zassert_ok(morse_store_erase(&store));
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 0U);
+	zassert_false(store.damaged);
+	zassert_true(morse_store_is_erased(&store, 0, store.fa->fa_size), "erase record left in flash");
+
+	zassert_ok(morse_store_add(&store, 0, "is"));
+	zassert_ok(morse_store_init(&store));
+	expect_plays(0, is, ARRAY_SIZE(is));
+}
+
+static void* store_setup(void)
+{
+	zassert_ok(morse_store_init(&store));
+	return NULL;
+}
+
+static void store_before(void* fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(flash_area_erase(store.fa, 0, store.fa->fa_size));
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 0U);
+}
+
+ZTEST(morse_store, test_add_then_reload)
+{
+	static const char* const geoff[] = { "geoff" };
+	static const char* const cha[] = { "cha" };
+	struct morse_store_cursor cur;
+	struct morse_bits_reader rd;
+
+	zassert_ok(morse_store_add(&store, 0, "geoff"));
+	zassert_ok(morse_store_add(&store, 1, "cha"));
+	zassert_equal(store.count, 0U, "added records are loaded before the next boot");
+	zassert_false(morse_store_reader(&store, &cur, 0, &rd));
+
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 2U);
+	expect_plays(0, geoff, ARRAY_SIZE(geoff));
+	expect_plays(1, cha, ARRAY_SIZE(cha));
+	zassert_false(morse_store_reader(&store, &cur, 2, &rd), "chan 2 was never given anything");
+}
+
+ZTEST(morse_store, test_channels_interleaved)
+{
+	static const char* const chan0[] = { "a", "paris", "e" };
+	static const char* const chan1[] = { "b", "cq cq de geoffcha" };
+	static const char* const chan2[] = { "c" };
+
+	zassert_ok(morse_store_add(&store, 0, chan0[0]));
+	zassert_ok(morse_store_add(&store, 1, chan1[0]));
+	zassert_ok(morse_store_add(&store, 0, chan0[1]));
+	zassert_ok(morse_store_add(&store, 2, chan2[0]));
+	zassert_ok(morse_store_add(&store, 1, chan1[1]));
+	zassert_ok(morse_store_add(&store, 0, chan0[2]));
+
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 6U);
+	expect_plays(0, chan0, ARRAY_SIZE(chan0));
+	expect_plays(1, chan1, ARRAY_SIZE(chan1));
+	expect_plays(2, chan2, ARRAY_SIZE(chan2));
+}
+
+ZTEST(morse_store, test_erase_at_next_init)
+{
+	static const char* const geoff[] = { "geoff" };
+	static const char* const is[] = { "is" };
+
+	zassert_ok(morse_store_add(&store, 0, "geoff"));
+	zassert_ok(morse_store_init(&store));
+
+	zassert_ok(morse_store_erase(&store));
+	expect_plays(0, geoff, ARRAY_SIZE(geoff));  // still there until the next boot
+	zassert_ok(morse_store_add(&store, 1, "cha"), "adding after an erase");
+
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 0U, "erase did not take the later record with it");
+	zassert_true(morse_store_is_erased(&store, 0, store.fa->fa_size));
+
+	zassert_ok(morse_store_add(&store, 0, "is"));
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 1U);
+	expect_plays(0, is, ARRAY_SIZE(is));
+}
+
+ZTEST(morse_store, test_full)
+{
+	uint32_t added = 0;
+	int ret;
+
+	while ((ret = morse_store_add(&store, added % 4U, "paris")) == 0) {
+		added++;
+	}
+	zassert_equal(ret, -ENOSPC);
+	zassert_true(added > 0U);
+	zassert_true(store.end <= store.fa->fa_size);
+	zassert_equal(morse_store_add(&store, 0, "e"), -ENOSPC, "no room, not even for a short one");
+
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, added);
+	zassert_false(store.damaged);
+
+	/* A full store can still be emptied. */
+	zassert_ok(morse_store_erase(&store));
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 0U);
+}
+
+ZTEST(morse_store, test_cut_short_before_the_header)
+{
+	zassert_ok(morse_store_add(&store, 0, "geoff"));
+	zassert_ok(morse_store_init(&store));
+	cut_short(1, "cha", false);
+	expect_recovery(1U);
+}
+
+ZTEST(morse_store, test_cut_short_in_the_header)
+{
+	zassert_ok(morse_store_add(&store, 0, "geoff"));
+	zassert_ok(morse_store_add(&store, 2, "chavez"));
+	zassert_ok(morse_store_init(&store));
+	cut_short(1, "cha", true);
+	expect_recovery(2U);
+}
+
+ZTEST(morse_store, test_cut_short_on_an_empty_store)
+{
+	cut_short(0, "geoff", true);
+	expect_recovery(0U);
+}
+
+ZTEST(morse_store, test_damage_with_no_room_left)
+{
+	static const uint8_t junk[MORSE_STORE_ALIGN] = { 0 };
+
+	zassert_ok(morse_store_add(&store, 0, "geoff"));
+	zassert_ok(flash_area_write(store.fa, store.fa->fa_size - sizeof(junk), junk, sizeof(junk)));
+
+	/* Not even an erase record fits after it: erased right away. */
+	zassert_ok(morse_store_init(&store));
+	zassert_equal(store.count, 0U);
+	zassert_false(store.damaged);
+	zassert_true(morse_store_is_erased(&store, 0, store.fa->fa_size));
+}
+
+ZTEST_SUITE(morse_store, NULL, store_setup, store_before, NULL, NULL);
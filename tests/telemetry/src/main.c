@@ -0,0 +1,181 @@
+/*
+ * Telemetry tests (native_sim): morse_telemetry_format() on its own, then the
+ * whole pipeline against the STTS22H emulator (emul/stts22h_emul.c) on the
+ * emulated I2C bus: timer -> work queue -> I2C read -> text -> morse_queue.
+ *
+ * The emulator ramps the temperature between 20.00 and 29.99 degC, one
+ * 0.01 degC step every 100 ms, and only answers at the stts22h node's
+ * address; a read from any other address fails like a missing chip.
+ */
+
+#include <string.h>               // strlen(), memset()
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>        // k_work, k_timer
+#include <zephyr/devicetree.h>    // DT_NODELABEL()
+#include <zephyr/drivers/i2c.h>   // I2C_DT_SPEC_GET(), i2c_burst_read_dt()
+#include <zephyr/sys/byteorder.h> // sys_get_le16()
+#include <zephyr/sys/util.h>      // WAIT_FOR()
+#include <morse_queue.h>          // morse_queue_pop()
+#include <morse_telemetry.h>      // (under test)
+
+#define TELEMETRY_CHAN 3
+#define PERIOD_MS 1000
+
+/* --- morse_telemetry_format() --- */
+
+static void check_format(int32_t centi, const char* want)
+{
+	char out[14 + 2];  // 14 promised, 2 to catch an overrun
+
+	memset(out, '#', sizeof(out));
+	size_t len = morse_telemetry_format(centi, out);
+
+	zassert_str_equal(out, want, "%d: \"%s\", want \"%s\"", centi, out, want);
+	zassert_equal(len, strlen(want), "%d: length %u", centi, (unsigned)len);
+	zassert_true(out[14] == '#' && out[15] == '#', "%d: wrote past 14 chars", centi);
+}
+
+ZTEST(morse_telemetry_format, test_format_rounds_to_tenths)
+{
+	check_format(2346, "23.5c");
+	check_format(2344, "23.4c");
+	check_format(2345, "23.5c");  // halves round up...
+	check_format(99, "1.0c");     // ... into the whole degrees too
+	check_format(2000, "20.0c");
+	check_format(5, "0.1c");
+	check_format(0, "0.0c");
+}
+
+ZTEST(morse_telemetry_format, test_format_negative)
+{
+	check_format(-2346, "-23.5c");
+	check_format(-2344, "-23.4c");
+	check_format(-2345, "-23.5c");  // away from zero, like the positive side
+	check_format(-100, "-1.0c");
+	check_format(-995, "-10.0c");
+	check_format(-5, "-0.1c");
+}
+
+ZTEST(morse_telemetry_format, test_format_no_minus_zero)
+{
+	check_format(-1, "0.0c");
+	check_format(-4, "0.0c");
+}
+
+ZTEST(morse_telemetry_format, test_format_largest)
+{
+	/* What the sensor can report... */
+	check_format(INT16_MAX, "327.7c");
+	check_format(INT16_MIN, "-327.7c");
+	/* ... and what the argument can hold. */
+	check_format(INT32_MAX, "21474836.5c");
+	check_format(INT32_MIN, "-21474836.5c");
+}
+
+ZTEST_SUITE(morse_telemetry_format, NULL, NULL, NULL, NULL, NULL);
+
+/* --- The pipeline, with the emulated sensor --- */
+
+static const struct i2c_dt_spec stts22h = I2C_DT_SPEC_GET(DT_NODELABEL(stts22h));
+static struct i2c_dt_spec nobody;  // same bus, an address nothing answers
+
+static struct morse_telemetry tm;
+static struct morse_queue q;
+K_SEM_DEFINE(wake, 0, 1);
+
+static void* telemetry_setup(void)
+{
+	nobody = stts22h;
+	nobody.addr = stts22h.addr + 1;
+
+	morse_queue_init(&q);
+	zassert_ok(morse_telemetry_start(&tm, &stts22h, &q, &wake, TELEMETRY_CHAN, PERIOD_MS));
+	return NULL;
+}
+
+/* Every test starts with the timer stopped, no read in flight and nothing queued. */
+static void telemetry_before(void* fixture)
+{
+	struct k_work_sync sync;
+	struct morse_update upd;
+
+	ARG_UNUSED(fixture);
+
+	k_timer_stop(&tm.timer);
+	k_work_flush(&tm.work, &sync);
+	zassert_true(WAIT_FOR(atomic_get(&tm.busy) == 0, 1000000, k_msleep(1)), "read still in flight");
+
+	tm.sensor = &stts22h;
+	tm.samples = 0;
+	tm.errors = 0;
+	while (morse_queue_pop(&q, &upd)) {
+	}
+	k_sem_reset(&wake);
+}
+
+ZTEST(morse_telemetry, test_start_needs_an_stts22h)
+{
+	static struct morse_telemetry other;
+
+	zassert_true(morse_telemetry_start(&other, &nobody, &q, &wake, 0, PERIOD_MS) < 0);
+}
+
+ZTEST(morse_telemetry, test_timer_sample_reaches_the_queue)
+{
+	struct morse_update upd;
+	uint8_t raw[2];
+	char want[14];
+
+	k_timer_start(&tm.timer, K_MSEC(100), K_MSEC(PERIOD_MS));
+	zassert_ok(k_sem_take(&wake, K_MSEC(PERIOD_MS)), "no reading within a period");
+	k_timer_stop(&tm.timer);
+
+	/* The sensor says the same now (or one step on), in the same byte order. */
+	zassert_ok(i2c_burst_read_dt(&stts22h, STTS22H_TEMP_L_OUT, raw, sizeof(raw)));
+	zassert_within((int16_t)sys_get_le16(raw), tm.last_centi, 1, "read %d, sensor says %d",
+	               tm.last_centi, (int16_t)sys_get_le16(raw));
+	zassert_true(tm.last_centi >= 2000 && tm.last_centi <= 2999, "%d is off the ramp", tm.last_centi);
+
+	zassert_true(morse_queue_pop(&q, &upd), "nothing queued");
+	zassert_equal(upd.chan, TELEMETRY_CHAN);
+	zassert_equal(upd.last, 1, "a reading is a batch of its own");
+	morse_telemetry_format(tm.last_centi, want);
+	zassert_str_equal(upd.text, want);
+	zassert_false(morse_queue_pop(&q, &upd), "more than one reading queued");
+
+	zassert_equal(tm.samples, 1U);
+	zassert_equal(tm.errors, 0U);
+}
+
+ZTEST(morse_telemetry, test_failed_read)
+{
+	struct morse_update upd;
+
+	tm.sensor = &nobody;
+	k_work_submit_to_queue(&telemetry_wq, &tm.work);
+	zassert_true(WAIT_FOR(tm.errors == 1U, 1000000, k_msleep(1)), "no error counted");
+	zassert_equal(atomic_get(&tm.busy), 0, "still busy after the error");
+	zassert_equal(tm.samples, 0U);
+	zassert_equal(k_sem_take(&wake, K_NO_WAIT), -EBUSY, "consumer woken");
+	zassert_false(morse_queue_pop(&q, &upd), "a failed read was queued");
+
+	/* Nothing is stuck: the next read goes out and comes back. */
+	tm.sensor = &stts22h;
+	k_work_submit_to_queue(&telemetry_wq, &tm.work);
+	zassert_ok(k_sem_take(&wake, K_MSEC(PERIOD_MS)), "no reading after the error");
+	zassert_equal(tm.samples, 1U);
+	zassert_equal(tm.errors, 1U);
+}
+
+ZTEST(morse_telemetry, test_read_in_flight_skips_a_sample)
+{
+	struct k_work_sync sync;
+
+	atomic_set(&tm.busy, 1);
+	k_work_submit_to_queue(&telemetry_wq, &tm.work);
+	k_work_flush(&tm.work, &sync);
+	zassert_equal(tm.samples + tm.errors, 0U, "a second read was started");
+	atomic_set(&tm.busy, 0);
+}
+
+ZTEST_SUITE(morse_telemetry, NULL, telemetry_setup, telemetry_before, NULL, NULL);
@@ -0,0 +1,195 @@
+/*
+ * Waveform tests (native_sim): plays known words and compares what the LED
+ * pins REALLY do against golden waveforms, written out by hand below.
+ *
+ *   1) setup_leds() must leave every pin configured and OFF, set_leds() must
+ *      switch them all on and off (read back with gpio_emul_output_get()).
+ *   2) The one-timer scheduler (morse_sched.h) plays "geoff" and "chavez"
+ *      from build-time timelines, "digimon" and a whole sentence from
+ *      runtime-encoded bitstreams.
+ *   3) A second timer samples every pin in the MIDDLE of every unit T and
+ *      compares it with the golden waveform. A wrong dot/dash/gap, or timing
+ *      that drifts by half a unit anywhere in the run, shows up as a mismatch.
+ *
+ * Simulated time runs as fast as it can (prj.conf), so the default hour of
+ * Morse is over in seconds.
+ */
+
+#include <string.h>               // strlen()
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>        // k_timer
+#include <zephyr/devicetree.h>    // DT_NODELABEL()
+#include <zephyr/drivers/gpio.h>  // GPIO types for LEDs
+#include <zephyr/drivers/gpio/gpio_emul.h>  // gpio_emul_output_get()
+#include <zephyr/sys/util.h>      // ARRAY_SIZE, MAX
+#include <leds_funcs.h>           // setup_leds(), set_leds() (under test)
+#include <morse_timeline.h>       // MORSE_TIMELINE_DEFINE() (under test)
+#include <morse_sched.h>          // morse_sched_start() (under test)
+#include <morse_bits.h>           // morse_bits_encode() (under test)
+
+/* Length of T; any value works, simulated time does not care. */
+#define T_MS 10
+
+/* How much Morse to check (simulated seconds). */
+#ifndef WAVEFORM_SECONDS
+#define WAVEFORM_SECONDS 3600
+#endif
+
+#define NUM_LEDS 4
+
+static const struct gpio_dt_spec gds_leds[NUM_LEDS] = {
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led0), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led1), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led2), gpios),
+	GPIO_DT_SPEC_GET(DT_NODELABEL(led3), gpios),
+};
+
+static const struct gpio_dt_spec* p_gds_leds[NUM_LEDS] = {
+	&gds_leds[0], &gds_leds[1], &gds_leds[2], &gds_leds[3]
+};
+
+/*
+ * Golden waveforms, one character per unit T: '=' = ON, '.' = OFF.
+ * Written from the ITU chart, NOT from morse_table[], so a wrong table entry
+ * is caught too. Each one loops (it ends in the 7T word gap).
+ */
+static const char* const golden[NUM_LEDS] = {
+	/* geoff:   G --.  E .  O ---  F ..-.  F ..-. */
+	"===.===.=...=...===.===.===...=.=.===.=...=.=.===.=.......",
+	/* chavez:  C -.-.  H ....  A .-  V ...-  E .  Z --.. */
+	"===.=.===.=...=.=.=.=...=.===...=.=.=.===...=...===.===.=.=.......",
+	/* digimon: D -..  I ..  G --.  I ..  M --  O ---  N -. */
+	"===.=.=...=.=...===.===.=...=.=...===.===...===.===.===...===.=.......",
+	/* "geoff chavez digimon" */
+	"===.===.=...=...===.===.===...=.=.===.=...=.=.===.=......."
+	"===.=.===.=...=.=.=.=...=.===...=.=.=.===...=...===.===.=.=......."
+	"===.=.=...=.=...===.===.=...=.=...===.===...===.===.===...===.=.......",
+};
+
+/* Built-in timelines for LED0 and LED1. */
+MORSE_TIMELINE_DEFINE(tl_geoff, G, E, O, F, F);
+MORSE_TIMELINE_DEFINE(tl_chavez, C, H, A, V, E, Z);
+
+/* Runtime-encoded bitstreams for LED2 and LED3. */
+static uint8_t digimon_bits[16];
+static uint8_t sentence_bits[32];
+static struct morse_bits_reader digimon_msg;
+static struct morse_bits_reader sentence_msg;
+
+static struct morse_chan chans[NUM_LEDS] = {
+	{ .led = &gds_leds[0], .units = tl_geoff,  .num_units = ARRAY_SIZE(tl_geoff) },
+	{ .led = &gds_leds[1], .units = tl_chavez, .num_units = ARRAY_SIZE(tl_chavez) },
+	{ .led = &gds_leds[2], .bits = &digimon_msg },
+	{ .led = &gds_leds[3], .bits = &sentence_msg },
+};
+
+static struct morse_sched sched;
+
+/* --- Sampler: one look at every pin in the middle of every unit --- */
+
+static struct k_timer sample_timer;
+static uint32_t samples;                    // units checked so far (per LED)
+static uint32_t mismatches[NUM_LEDS];
+static uint32_t first_mismatch[NUM_LEDS];   // unit number of the first one
+K_SEM_DEFINE(waveform_done, 0, 1);
+
+static void sample_expiry(struct k_timer* timer)
+{
+	ARG_UNUSED(timer);
+
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		size_t len = strlen(golden[idx]);
+		int want = (golden[idx][samples % len] == '=');
+		int got = gpio_emul_output_get(gds_leds[idx].port, gds_leds[idx].pin);
+
+		if (got != want) {
+			if (mismatches[idx] == 0U) {
+				first_mismatch[idx] = samples;
+			}
+			mismatches[idx]++;
+		}
+	}
+
+	samples++;
+	if (samples == (uint32_t)WAVEFORM_SECONDS * 1000U / T_MS) {
+		k_timer_stop(&sample_timer);
+		k_sem_give(&waveform_done);
+	}
+}
+
+/* Every LED pin reads back as level (physical = logical, the LEDs are active high). */
+static bool all_leds_are(int level)
+{
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		if (gpio_emul_output_get(gds_leds[idx].port, gds_leds[idx].pin) != level) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* --- LED helpers --- */
+
+ZTEST(morse_waveform, test_setup_leds_leaves_leds_off)
+{
+	zassert_ok(setup_leds(p_gds_leds, NUM_LEDS));
+	zassert_true(all_leds_are(0), "setup_leds() left an LED on");
+}
+
+ZTEST(morse_waveform, test_set_leds)
+{
+	zassert_ok(setup_leds(p_gds_leds, NUM_LEDS));
+
+	set_leds(p_gds_leds, NUM_LEDS, true);
+	zassert_true(all_leds_are(1), "set_leds(true) left an LED off");
+	set_leds(p_gds_leds, NUM_LEDS, false);
+	zassert_true(all_leds_are(0), "set_leds(false) left an LED on");
+}
+
+/* --- Timelines and encoder agree with the chart on length alone... --- */
+
+ZTEST(morse_waveform, test_timeline_lengths)
+{
+	zassert_equal(MORSE_TIMELINE_UNITS(G, E, O, F, F), strlen(golden[0]));
+	zassert_equal(MORSE_TIMELINE_UNITS(C, H, A, V, E, Z), strlen(golden[1]));
+}
+
+ZTEST(morse_waveform, test_bitstream_lengths)
+{
+	zassert_equal(morse_bits_encode("digimon", digimon_bits, sizeof(digimon_bits)), (int)strlen(golden[2]));
+	zassert_equal(morse_bits_encode("geoff chavez digimon", sentence_bits, sizeof(sentence_bits)),
+	              (int)strlen(golden[3]));
+}
+
+/* --- ... and on every single unit, for WAVEFORM_SECONDS of playback --- */
+
+ZTEST(morse_waveform, test_golden_waveforms)
+{
+	zassert_ok(setup_leds(p_gds_leds, NUM_LEDS));
+
+	int nbits = morse_bits_encode("digimon", digimon_bits, sizeof(digimon_bits));
+	zassert_true(nbits > 0);
+	morse_bits_reader_init(&digimon_msg, digimon_bits, (size_t)nbits, NULL, NULL);
+
+	nbits = morse_bits_encode("geoff chavez digimon", sentence_bits, sizeof(sentence_bits));
+	zassert_true(nbits > 0);
+	morse_bits_reader_init(&sentence_msg, sentence_bits, (size_t)nbits, NULL, NULL);
+
+	zassert_ok(morse_sched_start(&sched, chans, NUM_LEDS, T_MS));
+
+	/* Everything starts at chans[].next_edge; sample half a unit later, then every unit. */
+	k_timer_init(&sample_timer, sample_expiry, NULL);
+	k_timer_start(&sample_timer, K_TIMEOUT_ABS_TICKS(chans[0].next_edge + sched.unit_ticks / 2),
+	              K_TICKS(sched.unit_ticks));
+
+	k_sem_take(&waveform_done, K_FOREVER);
+	morse_sched_stop(&sched);
+
+	TC_PRINT("%u units per LED, %u wakeups, %u edges\n", samples, sched.wakeups, sched.edges);
+	for (size_t idx = 0; idx < NUM_LEDS; idx++) {
+		zassert_equal(mismatches[idx], 0U, "LED%u: %u wrong units, first at unit %u", (unsigned)idx,
+		              mismatches[idx], first_mismatch[idx]);
+	}
+}
+
+ZTEST_SUITE(morse_waveform, NULL, NULL, NULL, NULL, NULL);
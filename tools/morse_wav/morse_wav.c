@@ -0,0 +1,333 @@
+/*
+ * morse_wav.c
+ *
+ * Host tool: renders a message as Morse sidetone audio into a WAV file
+ * (16-bit mono PCM), for listening to or analyzing what the LEDs send.
+ *
+ *   morse_wav [-o out.wav] [-w wpm] [-f tone Hz] [-r sample rate] [-e edge ms]
+ *             [-n repeats] text...
+ *
+ * The text goes through morse_bits_encode() and is played back with
+ * morse_bits_next_run(), the same code and the same bitstream the firmware
+ * plays on an LED (inc/morse.h, inc/morse_bits.h), so the audio cannot say
+ * anything the LED would not. Like a channel, the message loops: -n 3600 at
+ * 20 WPM is about an hour of "paris" traffic.
+ *
+ * The tone sounds exactly while the LED is on: each mark rises over the first
+ * "edge" milliseconds and falls over its last ones with a raised-cosine
+ * (Hann) envelope, which keeps key clicks out of the spectrum. Gaps are
+ * silence. A unit T is a whole number of samples (1200 / wpm ms, rounded),
+ * so marks and gaps land on the same sample grid for the whole file.
+ *
+ * Rendering is done in blocks of RENDER_BLOCK samples: one sin()/cos() per
+ * block for its start phase, then a fixed-length loop of multiply-adds
+ * against per-block tables (sin(a + kw) = sin a cos kw + cos a sin kw) that
+ * the compiler vectorizes. Long marks and gaps cost no per-unit work.
+ */
+
+#include <errno.h>      // EINVAL, EIO, ENOMEM
+#include <math.h>       // sin(), cos(), lround()
+#include <stdbool.h>    // bool
+#include <stdint.h>     // int16_t, uint32_t
+#include <stdio.h>      // FILE, fprintf()
+#include <stdlib.h>     // strtol(), strtod()
+#include <string.h>     // strlen(), memset()
+#include <time.h>       // clock_gettime()
+#include <unistd.h>     // getopt()
+#include <morse.h>      // morse_lookup(), MORSE_*_UNITS
+#include <morse_bits.h> // morse_bits_encode(), morse_bits_next_run()
+
+#define RENDER_BLOCK 64    // samples per oscillator block (one sin/cos each)
+#define OUT_SAMPLES  8192  // samples buffered before each fwrite()
+#define MAX_TEXT     1024  // characters of text, spaces included
+
+#define AMPLITUDE 0.7f     // peak level of the tone, of full scale
+
+struct wav_opts {
+	const char* path;
+	double wpm;
+	double tone_hz;
+	uint32_t rate;
+	double edge_ms;
+	long repeats;
+};
+
+/* Sidetone oscillator and keying envelope, all in samples. */
+struct tone {
+	double w;                    // radians per sample
+	float cos_kw[RENDER_BLOCK];  // cos(k w), sin(k w): a block's phase steps
+	float sin_kw[RENDER_BLOCK];
+	uint32_t edge;               // samples of rise (and of fall)
+	float* ramp;                 // edge samples of the rising raised cosine
+};
+
+/* WAV output, written as the samples come. */
+struct wav_out {
+	FILE* f;
+	int16_t buf[OUT_SAMPLES];
+	size_t used;
+	uint64_t samples;            // rendered so far (buffered or written)
+	int err;
+};
+
+static void usage(const char* prog)
+{
+	fprintf(stderr,
+	        "usage: %s [-o out.wav] [-w wpm] [-f tone Hz] [-r sample rate] [-e edge ms] [-n repeats] text...\n"
+	        "  defaults: -o morse.wav -w 20 -f 700 -r 8000 -e 5 -n 1\n",
+	        prog);
+}
+
+/* Little-endian fields of the WAV header. */
+static void put_le16(uint8_t* p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t* p, uint32_t v)
+{
+	put_le16(p, v);
+	put_le16(p + 2, v >> 16);
+}
+
+/* RIFF/WAVE header for nsamples of 16-bit mono PCM. */
+static int wav_header(FILE* f, uint32_t rate, uint64_t nsamples)
+{
+	uint8_t h[44];
+	uint32_t data_bytes = (uint32_t)(nsamples * 2U);
+
+	memcpy(h, "RIFF", 4);
+	put_le32(h + 4, 36U + data_bytes);
+	memcpy(h + 8, "WAVEfmt ", 8);
+	put_le32(h + 16, 16U);        // fmt chunk size
+	put_le16(h + 20, 1U);         // PCM
+	put_le16(h + 22, 1U);         // mono
+	put_le32(h + 24, rate);
+	put_le32(h + 28, rate * 2U);  // bytes per second
+	put_le16(h + 32, 2U);         // bytes per sample frame
+	put_le16(h + 34, 16U);        // bits per sample
+	memcpy(h + 36, "data", 4);
+	put_le32(h + 40, data_bytes);
+
+	return (fwrite(h, sizeof(h), 1, f) == 1) ? 0 : -EIO;
+}
+
+static void wav_flush(struct wav_out* out)
+{
+	if (out->used != 0U && out->err == 0 && fwrite(out->buf, sizeof(out->buf[0]), out->used, out->f) != out->used) {
+		out->err = -EIO;
+	}
+	out->used = 0;
+}
+
+/* Room for at least one more block in out->buf. */
+static int16_t* wav_block(struct wav_out* out)
+{
+	if (out->used + RENDER_BLOCK > OUT_SAMPLES) {
+		wav_flush(out);
+	}
+	return &out->buf[out->used];
+}
+
+static int tone_init(struct tone* t, const struct wav_opts* o, uint32_t unit)
+{
+	t->w = 2.0 * M_PI * o->tone_hz / o->rate;
+	for (int k = 0; k < RENDER_BLOCK; k++) {
+		t->cos_kw[k] = (float)cos(k * t->w);
+		t->sin_kw[k] = (float)sin(k * t->w);
+	}
+
+	/* A dot has to fit a full rise and fall. */
+	t->edge = (uint32_t)lround(o->edge_ms * o->rate / 1000.0);
+	if (t->edge > unit / 2U) {
+		t->edge = unit / 2U;
+	}
+	t->ramp = malloc((t->edge + 1U) * sizeof(float));
+	if (t->ramp == NULL) {
+		return -ENOMEM;
+	}
+	for (uint32_t i = 0; i < t->edge; i++) {
+		t->ramp[i] = (float)(0.5 - 0.5 * cos(M_PI * (i + 0.5) / t->edge));
+	}
+	return 0;
+}
+
+/* The envelope at sample i of a mark that is len samples long. */
+static inline float tone_env(const struct tone* t, uint32_t i, uint32_t len)
+{
+	if (i < t->edge) {
+		return t->ramp[i];
+	}
+	if (len - 1U - i < t->edge) {
+		return t->ramp[len - 1U - i];
+	}
+	return 1.0f;
+}
+
+/* A mark: len samples of tone, the phase taken from the absolute sample number. */
+static void render_mark(struct wav_out* out, const struct tone* t, uint32_t len)
+{
+	float env[RENDER_BLOCK];
+	float y[RENDER_BLOCK];
+
+	for (uint32_t i = 0; i < len; i += RENDER_BLOCK) {
+		uint32_t n = (len - i < RENDER_BLOCK) ? len - i : RENDER_BLOCK;
+		double a = fmod((double)out->samples * t->w, 2.0 * M_PI);
+		float sa = (float)(AMPLITUDE * 32767.0 * sin(a));
+		float ca = (float)(AMPLITUDE * 32767.0 * cos(a));
+		int16_t* dst = wav_block(out);
+
+		/* Only the first and last edge samples of the mark are not 1. */
+		if (i >= t->edge && i + RENDER_BLOCK + t->edge <= len) {
+			for (int k = 0; k < RENDER_BLOCK; k++) {
+				env[k] = 1.0f;
+			}
+		} else {
+			for (uint32_t k = 0; k < RENDER_BLOCK; k++) {
+				env[k] = (k < n) ? tone_env(t, i + k, len) : 0.0f;
+			}
+		}
+
+		/* The kernel: fixed trip count, no branches, vectorizes. */
+		for (int k = 0; k < RENDER_BLOCK; k++) {
+			y[k] = env[k] * (sa * t->cos_kw[k] + ca * t->sin_kw[k]);
+		}
+		for (uint32_t k = 0; k < n; k++) {
+			dst[k] = (int16_t)lrintf(y[k]);
+		}
+		out->used += n;
+		out->samples += n;
+	}
+}
+
+/* A gap: len samples of silence. */
+static void render_gap(struct wav_out* out, uint32_t len)
+{
+	while (len > 0U) {
+		uint32_t n = OUT_SAMPLES - (uint32_t)out->used;
+		if (n > len) {
+			n = len;
+		}
+		memset(&out->buf[out->used], 0, n * sizeof(out->buf[0]));
+		out->used += n;
+		out->samples += n;
+		len -= n;
+		if (out->used == OUT_SAMPLES) {
+			wav_flush(out);
+		}
+	}
+}
+
+static int parse_args(int argc, char** argv, struct wav_opts* o, char* text, size_t text_len)
+{
+	int c;
+
+	*o = (struct wav_opts){ .path = "morse.wav", .wpm = 20.0, .tone_hz = 700.0, .rate = 8000U,
+	                        .edge_ms = 5.0, .repeats = 1 };
+
+	while ((c = getopt(argc, argv, "o:w:f:r:e:n:h")) != -1) {
+		switch (c) {
+		case 'o': o->path = optarg; break;
+		case 'w': o->wpm = strtod(optarg, NULL); break;
+		case 'f': o->tone_hz = strtod(optarg, NULL); break;
+		case 'r': o->rate = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 'e': o->edge_ms = strtod(optarg, NULL); break;
+		case 'n': o->repeats = strtol(optarg, NULL, 10); break;
+		default: return -EINVAL;
+		}
+	}
+	if (optind >= argc || o->wpm <= 0.0 || o->rate < 1000U || o->rate > 192000U || o->tone_hz <= 0.0 ||
+	    o->tone_hz >= o->rate / 2.0 || o->edge_ms < 0.0 || o->repeats < 1) {
+		return -EINVAL;
+	}
+
+	/* The words of the command line, one space apart. */
+	text[0] = '\0';
+	for (int i = optind; i < argc; i++) {
+		if (strlen(text) + strlen(argv[i]) + 2U > text_len) {
+			return -ENOMEM;
+		}
+		if (i > optind) {
+			strcat(text, " ");
+		}
+		strcat(text, argv[i]);
+	}
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	static char text[MAX_TEXT + 1];
+	static uint8_t bits[MORSE_BITS_BYTES(MORSE_BITS_MAX_PER_CHAR * MAX_TEXT)];
+	static struct wav_out out;
+	struct wav_opts o;
+	struct tone t;
+	struct timespec t0, t1;
+
+	if (parse_args(argc, argv, &o, text, sizeof(text)) < 0) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	int nbits = morse_bits_encode(text, bits, sizeof(bits));
+	if (nbits < 0) {
+		fprintf(stderr, "morse_wav: nothing to send in \"%s\"\n", text);
+		return 1;
+	}
+
+	/* T = 1200 / wpm ms ("paris" = 50 units per word), a whole number of samples. */
+	uint32_t unit = (uint32_t)lround(1.2 * o.rate / o.wpm);
+	if (unit < 2U || (uint64_t)nbits * unit * (uint64_t)o.repeats > (UINT32_MAX - 36U) / 2U) {
+		fprintf(stderr, "morse_wav: unit of %u samples, or more audio than a WAV file holds\n", unit);
+		return 1;
+	}
+	if (tone_init(&t, &o, unit) < 0) {
+		fprintf(stderr, "morse_wav: out of memory\n");
+		return 1;
+	}
+
+	out.f = fopen(o.path, "wb");
+	if (out.f == NULL) {
+		perror(o.path);
+		return 1;
+	}
+	uint64_t total = (uint64_t)nbits * unit * (uint64_t)o.repeats;
+	out.err = wav_header(out.f, o.rate, total);
+
+	/* Play the bitstream the way a channel does: run by run, looping. */
+	struct morse_bits_reader rd;
+	morse_bits_reader_init(&rd, bits, (size_t)nbits, NULL, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (long r = 0; r < o.repeats && out.err == 0; r++) {
+		uint32_t run;
+		bool on;
+
+		morse_bits_rewind(&rd);
+		while ((run = morse_bits_next_run(&rd, &on)) != 0U) {
+			if (on) {
+				render_mark(&out, &t, run * unit);
+			} else {
+				render_gap(&out, run * unit);
+			}
+		}
+	}
+	wav_flush(&out);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	if (fclose(out.f) != 0 && out.err == 0) {
+		out.err = -EIO;
+	}
+	free(t.ramp);
+	if (out.err < 0) {
+		fprintf(stderr, "morse_wav: cannot write %s\n", o.path);
+		return 1;
+	}
+
+	double audio_s = (double)total / o.rate;
+	double render_s = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	fprintf(stderr, "morse_wav: %s: \"%s\" x %ld, %d units of %u samples, %.1f s of audio in %.3f s (x%.0f)\n",
+	        o.path, text, o.repeats, nbits, unit, audio_s, render_s, audio_s / (render_s > 0.0 ? render_s : 1e-9));
+	return 0;
+}